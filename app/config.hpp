@@ -13,9 +13,28 @@
 namespace mfx::config
 {
 
-/* Buffer size of audio samples (directly affects in/out latency) */
+/* Default buffer size of audio samples (directly affects in/out latency), also processing block of fixed-block effects */
 constexpr inline size_t dsp_buffer_size {128};
 
+/* Range of buffer sizes selectable at runtime (powers of 2), DSP buffers are allocated for the largest one */
+constexpr inline size_t dsp_min_buffer_size {32};
+constexpr inline size_t dsp_max_buffer_size {256};
+
+/* Number of samples between control points of modulated parameters (values are interpolated in between) */
+constexpr inline uint32_t control_rate_period {16};
+
+/* Number of blocks, over which old & new effect chains are crossfaded when preset is switched */
+constexpr inline uint8_t dsp_chain_crossfade_blocks {3};
+
+/* Peak level of block treated as silence (-120dBFS), effects with silent input & tail are not processed */
+constexpr inline float dsp_silence_threshold {1e-6f};
+
+/* Number of blocks, over which CM7-only & pipelined outputs are crossfaded when CM4 stage starts or stops */
+constexpr inline uint8_t dsp_pipeline_crossfade_blocks {4};
+
+/* Estimated ratio of effect time on CM4 to time on CM7 (in CM7 cycles), used until effect is measured on CM4 */
+constexpr inline float dsp_pipeline_cm4_cost_ratio {2.5f};
+
 /* Sampling frequency of audio signals */
 constexpr inline uint32_t sampling_frequency_hz {48000 + CFG_FS_CALIB};
 
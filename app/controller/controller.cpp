@@ -23,7 +23,11 @@ namespace events = controller_events;
 
 namespace
 {
-
+    void print_time_stats(const char *name, const char *quality, const effect_processor_events::dsp_time_stats &s)
+    {
+        printf("%-20.20s %4s %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %8lu\r\n", name, quality,
+               s.min, s.avg, s.p50, s.p99, s.p999, s.max, static_cast<unsigned long>(s.misses));
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -61,6 +65,7 @@ void controller::event_handler(const controller_events::initialize &e)
         this->settings->get_mic_routed_to_aux(),
         this->settings->get_usb_audio_if_enabled(),
         this->settings->get_usb_direct_mon_enabled(),
+        this->settings->get_dsp_block_size(),
     }});
 
     this->view->send({lcd_view_events::configuration
@@ -126,6 +131,8 @@ void controller::event_handler(const events::button_state_changed &e)
 
         struct mallinfo mi = mallinfo();
         printf("Heap used: %d bytes\r\n", mi.uordblks);
+
+        this->model->send({effect_processor_events::get_dsp_profile {false}});
     }
     else if (e.state == events::button_state_changed::state::released)
     {
@@ -207,34 +214,28 @@ void controller::view_event_handler(const lcd_view_events::load_preset &e)
 
     printf("Loading preset: '%s'...\r\n", preset_name);
 
-    this->model->send({effect_processor_events::set_mute {true}});
-
-    for (auto id : this->active_effects)
-        this->model->send({effect_processor_events::remove_effect {id}});
-
     this->active_effects.clear();
 
+    /* New chain is prepared aside & replaced at once (with crossfade), so audio is not interrupted */
     auto effect_callback = [this](effect_id id, const char *name, bool bypassed, const effect_controls &ctrl)
     {
         printf("Effect '%s' loaded from preset\r\n", name);
 
         this->active_effects.push_back(id);
-        this->model->send({effect_processor_events::add_effect {id}});
-        this->model->send({effect_processor_events::bypass_effect {id, bypassed}});
-        this->model->send({effect_processor_events::set_effect_controls {ctrl}});
+        this->model->send({effect_processor_events::stage_effect {id, bypassed, ctrl}});
     };
 
     bool result = this->presets->load(preset_name, effect_callback);
 
     printf("Preset loading %s\r\n", result ? "successful" : "failed");
 
+    this->model->send({effect_processor_events::commit_chain {config::dsp_chain_crossfade_blocks}});
+
     this->current_effect = this->active_effects.at(0);
 
     this->view->send({lcd_view_events::update_effects_list {this->active_effects}});
     this->view->send({lcd_view_events::show_next_effect_screen {this->current_effect}});
     this->update_effect_attributes(this->current_effect);
-
-    this->model->send({effect_processor_events::set_mute {false}});
 }
 
 void controller::view_event_handler(const lcd_view_events::save_preset &e)
@@ -342,12 +343,12 @@ void controller::view_event_handler(const lcd_view_events::usb_direct_mon_change
 
 void controller::view_event_handler(const lcd_view_events::effect_bypass_changed &e)
 {
-    this->model->send({effect_processor_events::bypass_effect {e.id, e.bypassed}});
+    this->model->send_control(effect_processor_events::bypass_effect {e.id, e.bypassed});
 }
 
 void controller::view_event_handler(const lcd_view_events::effect_controls_changed &e)
 {
-    this->model->send({effect_processor_events::set_effect_controls {e.ctrl}});
+    this->model->send_control(effect_processor_events::set_effect_controls {e.ctrl, e.changed});
 }
 
 void controller::view_event_handler(const lcd_view_events::add_effect_request &e)
@@ -421,6 +422,13 @@ void controller::model_event_handler(const effect_processor_events::dsp_load_cha
     this->view->send({lcd_view_events::update_dsp_load {e.load_pct}});
 }
 
+void controller::model_event_handler(const effect_processor_events::dsp_overload &e)
+{
+    /* Effect attributes (bypass state) are updated separately by model */
+    printf("DSP overload: %s %s (xruns: %lu)\r\n", effect_name[static_cast<uint8_t>(e.id)],
+           e.degraded ? "bypassed" : "restored", static_cast<unsigned long>(e.xruns));
+}
+
 void controller::model_event_handler(const effect_processor_events::mute_changed &e)
 {
     this->view->send({lcd_view_events::update_mute {e.value}});
@@ -459,6 +467,59 @@ void controller::model_event_handler(const effect_processor_events::effect_attri
     }
 }
 
+void controller::model_event_handler(const effect_processor_events::dsp_profile_summary &e)
+{
+    printf("DSP profile: %lu blocks of %u samples, budget %.1f us\r\n",
+           static_cast<unsigned long>(e.blocks), e.block_size, e.budget_us);
+    printf("Xruns: %lu\r\n", static_cast<unsigned long>(e.xruns));
+
+    /* Effects processed by CM4 have only average time, measured on CM4 */
+    if (e.cm4_active)
+        printf("CM4 pipeline: load %u%%, misses %lu\r\n", e.cm4_load_pct, static_cast<unsigned long>(e.cm4_misses));
+
+    printf("%-20s %4s %8s %8s %8s %8s %8s %8s %8s\r\n", "[us]", "q", "min", "avg", "p50", "p99", "p99.9", "max", "misses");
+    print_time_stats("Total", "-", e.total);
+}
+
+void controller::model_event_handler(const effect_processor_events::dsp_profile_effect &e)
+{
+    constexpr std::array<const char*, static_cast<uint8_t>(effect_quality::_count)> quality_name {"low", "med", "high"};
+    const char *name = effect_name[static_cast<uint8_t>(e.id)];
+
+    if (e.on_cm4)
+        printf("%-20.20s %4s %8s %8.1f (CM4)\r\n", name, "-", "-", e.time.avg);
+    else
+        print_time_stats(name, e.quality ? quality_name[static_cast<uint8_t>(*e.quality)] : "-", e.time);
+}
+
+void controller::model_event_handler(const effect_processor_events::dsp_block_size_changed &e)
+{
+    printf("DSP block size: %u samples\r\n", e.samples);
+    for (uint8_t i = 0; i < static_cast<uint8_t>(effect_id::_count); i++)
+    {
+        if (e.buffered_effects & (1UL << i))
+            printf("- %s: buffered to fixed block (adds latency)\r\n", effect_name[i]);
+    }
+}
+
+void controller::model_event_handler(const effect_processor_events::routing_changed &e)
+{
+    if (e.accepted)
+        printf("Effects routing: %u nodes, %u buffers\r\n", e.nodes, e.buffers);
+    else
+        printf("Effects routing rejected (cycle, invalid node or too many parallel branches)\r\n");
+}
+
+void controller::model_event_handler(const effect_processor_events::dsp_pipeline_changed &e)
+{
+    constexpr std::array<const char*, 3> mode_name {"off", "manual", "automatic"};
+
+    if (e.supported)
+        printf("DSP pipeline: %s\r\n", mode_name[static_cast<uint8_t>(e.mode)]);
+    else
+        printf("DSP pipeline: not supported (single core)\r\n");
+}
+
 void controller::update_effect_attributes(effect_id id)
 {
     this->model->send({effect_processor_events::get_effect_attributes {id}});
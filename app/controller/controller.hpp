@@ -125,12 +125,18 @@ private:
     void view_event_handler(const lcd_view_events::move_effect_request &e);
 
     void model_event_handler(const effect_processor_events::dsp_load_changed &e);
+    void model_event_handler(const effect_processor_events::dsp_overload &e);
     void model_event_handler(const effect_processor_events::mute_changed &e);
     void model_event_handler(const effect_processor_events::volume_range_info &e);
     void model_event_handler(const effect_processor_events::input_volume_changed &e);
     void model_event_handler(const effect_processor_events::output_volume_changed &e);
     void model_event_handler(const effect_processor_events::effect_attributes_changed &e);
     void model_event_handler(const effect_processor_events::effect_attributes_enumerated &e);
+    void model_event_handler(const effect_processor_events::dsp_profile_summary &e);
+    void model_event_handler(const effect_processor_events::dsp_profile_effect &e);
+    void model_event_handler(const effect_processor_events::dsp_block_size_changed &e);
+    void model_event_handler(const effect_processor_events::routing_changed &e);
+    void model_event_handler(const effect_processor_events::dsp_pipeline_changed &e);
 
     void update_effect_attributes(effect_id id);
 
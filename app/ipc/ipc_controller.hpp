@@ -86,8 +86,13 @@ private:
         const size_t bytes_received = hal::ipc::receive_from_cm4(&evt, sizeof(evt));
         if (bytes_received == sizeof(evt))
         {
-            /* Send event to model */
-            this->model->send({std::move(evt)});
+            /* Send event to model (parameter changes via control channel) */
+            if (auto *c = std::get_if<effect_processor_events::set_effect_controls>(&evt))
+                this->model->send_control(*c);
+            else if (auto *c = std::get_if<effect_processor_events::bypass_effect>(&evt))
+                this->model->send_control(*c);
+            else
+                this->model->send({std::move(evt)});
         }
     }
 
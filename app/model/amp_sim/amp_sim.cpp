@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <array>
 
 #include <hal/hal_system.hpp>
 
@@ -36,7 +37,7 @@ attr {}
     this->amp.reset(config::sampling_frequency_hz);
 
     /* For performance reasons, use one triode preamp (instead of four) on slower systems */
-    this->amp_params.singleTriodePreamp = (hal::system::system_clock <= 200000000);
+    this->set_quality(hal::system::system_clock <= 200000000 ? effect_quality::low : effect_quality::medium);
 
     const auto& def = amp_sim_attr::default_ctrl;
 
@@ -54,10 +55,15 @@ amp_sim::~amp_sim()
 
 void amp_sim::process(const dsp_input& in, dsp_output& out)
 {
-    std::transform(in.begin(), in.end(), out.begin(),
-    [this](auto input)
+    this->oversampler.process(in.data(), out.data(), in.size(),
+    [this](float *samples, uint32_t n)
     {
-        return this->amp.processAudioSample(input);
+        std::transform(samples, samples + n, samples,
+        [this](auto input)
+        {
+            return this->amp.processAudioSample(input);
+        }
+        );
     }
     );
 }
@@ -67,6 +73,12 @@ const effect_specific_attr amp_sim::get_specific_attributes(void) const
     return this->attr;
 }
 
+uint32_t amp_sim::tail_length(void) const
+{
+    /* Only filters of amp model */
+    return config::sampling_frequency_hz / 100;
+}
+
 void amp_sim::set_input(float input)
 {
     input = std::clamp(input, 0.0f, 1.0f);
@@ -149,3 +161,32 @@ void amp_sim::set_mode(amp_sim_attr::controls::mode_type mode)
     this->amp.setParameters(this->amp_params);
 }
 
+void amp_sim::set_quality(effect_quality level)
+{
+    /* Low: one triode preamp, medium: four triodes preamp, high: four triodes preamp with x2 oversampling */
+    this->amp_params.singleTriodePreamp = (level == effect_quality::low);
+    this->amp.setParameters(this->amp_params);
+    this->set_oversampling(level == effect_quality::high ? 2 : 1);
+    this->quality = level;
+}
+
+uint32_t amp_sim::cost_estimate(effect_quality level) const
+{
+    /* Preamp triodes dominate, oversampling doubles the cost of whole model */
+    constexpr std::array<uint32_t, static_cast<uint8_t>(effect_quality::_count)> cost {2, 5, 11};
+    return cost.at(static_cast<uint8_t>(level));
+}
+
+void amp_sim::set_oversampling(uint8_t factor)
+{
+    factor = std::clamp<uint8_t>(factor, 1, max_oversampling_factor);
+
+    if (this->oversampler.get_factor() == factor)
+        return;
+
+    this->oversampler.set_factor(factor);
+
+    /* Amp model runs at oversampled rate */
+    this->amp.reset(config::sampling_frequency_hz * factor);
+    this->amp.setParameters(this->amp_params);
+}
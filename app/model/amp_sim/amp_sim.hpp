@@ -25,18 +25,27 @@ public:
 
     void process(const dsp_input &in, dsp_output &out) override;
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
 
     void set_input(float input);
     void set_drive(float drive);
     void set_compression(float compression);
     void set_tone_stack(float bass, float mids, float treb);
     void set_mode(amp_sim_attr::controls::mode_type mode);
+    void set_oversampling(uint8_t factor);
+
+    void set_quality(effect_quality level) override;
+    uint32_t cost_estimate(effect_quality level) const override;
 
 private:
 
     OneMarkAmp amp;
     OneMarkAmpParameters amp_params;
 
+    /* Oversampling of amp model (disabled by default for performance reasons) */
+    constexpr static uint8_t max_oversampling_factor = 4;
+    libs::adsp::oversampler<max_oversampling_factor, config::dsp_max_buffer_size> oversampler {1};
+
     amp_sim_attr attr {0};
 };
 
@@ -41,11 +41,14 @@ cabinet_sim::cabinet_sim() : effect { effect_id::cabinet_sim },
 attr {}
 {
     this->attr.ctrl.ir_idx = cabinet_sim_attr::default_ctrl.ir_idx;
+    this->attr.ctrl.ir_res = cabinet_sim_attr::default_ctrl.ir_res;
     this->fast_conv.set_ir(ir_map.at(this->attr.ctrl.ir_idx).second->data());
 
     for (unsigned i = 0; i < ir_map.size(); i++)
         this->attr.ir_names.at(i) = (ir_map.at(i).first);
 
+    this->set_quality(effect_quality::medium);
+
 }
 
 cabinet_sim::~cabinet_sim()
@@ -55,7 +58,40 @@ cabinet_sim::~cabinet_sim()
 
 void cabinet_sim::process(const dsp_input& in, dsp_output& out)
 {
-    this->fast_conv.process(in.data(), out.data());
+    /* Partition size is fixed, other block sizes are buffered */
+    this->adapter.process(in.data(), out.data(), in.size(),
+    [this](const auto &blk_in, float *blk_out)
+    {
+        this->fast_conv.process(blk_in[0], blk_out);
+    }
+    );
+}
+
+bool cabinet_sim::supports_block_size(size_t size) const
+{
+    return this->adapter.latency(size) == 0;
+}
+
+void cabinet_sim::set_quality(effect_quality level)
+{
+    using resolution = cabinet_sim_attr::controls::resolution;
+    constexpr std::array<resolution, static_cast<uint8_t>(effect_quality::_count)> levels
+    {{
+        resolution::low,
+        resolution::standart,
+        resolution::high,
+    }};
+
+    /* Quality is runtime state, it's not reflected in controls (which are stored in presets) */
+    this->fast_conv.set_length(static_cast<uint32_t>(levels.at(static_cast<uint8_t>(level))));
+    this->quality = level;
+}
+
+uint32_t cabinet_sim::cost_estimate(effect_quality level) const
+{
+    /* FFT & IFFT of block (~8 partitions) plus complex MAC per partition */
+    constexpr std::array<uint32_t, static_cast<uint8_t>(effect_quality::_count)> cost {12, 16, 24};
+    return cost.at(static_cast<uint8_t>(level));
 }
 
 const effect_specific_attr cabinet_sim::get_specific_attributes(void) const
@@ -63,6 +99,12 @@ const effect_specific_attr cabinet_sim::get_specific_attributes(void) const
     return this->attr;
 }
 
+uint32_t cabinet_sim::tail_length(void) const
+{
+    /* Convolved part of IR plus buffering of partitions */
+    return this->fast_conv.get_length() + config::dsp_buffer_size;
+}
+
 void cabinet_sim::set_ir(uint8_t idx)
 {
     if (idx >= this->attr.ir_names.size() || this->attr.ctrl.ir_idx == idx)
@@ -23,15 +23,20 @@ public:
 
     void process(const dsp_input &in, dsp_output &out) override;
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
+    bool supports_block_size(size_t size) const override;
+    void set_quality(effect_quality level) override;
+    uint32_t cost_estimate(effect_quality level) const override;
 
     void set_ir(uint8_t idx);
 
 private:
-    constexpr static cabinet_sim_attr::controls::resolution ir_res {cabinet_sim_attr::controls::resolution::standart};
-    constexpr static uint32_t ir_size {static_cast<uint32_t>(ir_res) - config::dsp_buffer_size};
+    /* Whole IR is transformed, quality level selects how much of it is convolved */
+    constexpr static uint32_t ir_size {static_cast<uint32_t>(cabinet_sim_attr::controls::resolution::high)};
 
-    /* FFT based convolution */
-    libs::adsp::fast_convolution<config::dsp_buffer_size, ir_size> fast_conv;
+    /* FFT based convolution (uniformly partitioned, cost grows only by complex MAC per partition) */
+    libs::adsp::partitioned_convolution<config::dsp_buffer_size, ir_size> fast_conv;
+    libs::adsp::fixed_block_adapter<config::dsp_buffer_size> adapter;
 
     cabinet_sim_attr attr {0};
 };
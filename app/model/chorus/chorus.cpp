@@ -17,6 +17,9 @@ using namespace mfx;
 namespace
 {
 
+/* Dry part of white chorus output */
+constexpr float white_blend = 0.7f;
+
 constexpr float delay_line1_tap = 0.01f;
 constexpr uint32_t delay_line1_tap_samples = delay_line1_tap * config::sampling_frequency_hz;
 __attribute__((section(".sdram")))
@@ -32,15 +35,47 @@ std::array<float, static_cast<unsigned>(2 * delay_line2_tap_samples)> delay_line
 //-----------------------------------------------------------------------------
 /* private */
 
+void chorus::process_voices(const float *in, float *out, uint32_t n)
+{
+    const float depth = 0.0001f + this->attr.ctrl.depth * 0.0015f;
+
+    /* Modulated delays (in samples) are calculated at control rate */
+    this->delay1_mod.process(this->delay1.data(), n,
+    [this, depth](uint32_t samples)
+    {
+        return (delay_line1_tap + this->lfo1.advance(samples) * depth) * config::sampling_frequency_hz;
+    }
+    );
+
+    if (this->attr.ctrl.mode == chorus_attr::controls::mode_type::white)
+    {
+        this->unicomb1.process<false, true, delay_line1_tap_samples>(in, out, this->delay1.data(), n);
+    }
+    else
+    {
+        this->delay2_mod.process(this->delay2.data(), n,
+        [this, depth](uint32_t samples)
+        {
+            return (delay_line2_tap + this->lfo2.advance(samples) * depth) * config::sampling_frequency_hz;
+        }
+        );
+
+        this->unicomb1.process<false, true, 0>(in, out, this->delay1.data(), n);
+        this->unicomb2.process<false, true, 0>(in, this->out2.data(), this->delay2.data(), n);
+    }
+}
+
 //-----------------------------------------------------------------------------
 /* public */
 
 
 chorus::chorus() : effect { effect_id::chorus },
-lfo1 { libs::adsp::oscillator::shape::sine, 0.2f, config::sampling_frequency_hz },
-lfo2 { libs::adsp::oscillator::shape::cosine, 0.2f, config::sampling_frequency_hz },
-unicomb1 { 0.7f, -0.7f, 1, delay_line1_memory.data(), delay_line1_memory.size(), config::sampling_frequency_hz},
+lfo1 { libs::adsp::wavetable_oscillator::shape::sine, 0.2f, config::sampling_frequency_hz },
+lfo2 { libs::adsp::wavetable_oscillator::shape::cosine, 0.2f, config::sampling_frequency_hz },
+unicomb1 { white_blend, -0.7f, 1, delay_line1_memory.data(), delay_line1_memory.size(), config::sampling_frequency_hz},
 unicomb2 { 0, 0, 1, delay_line2_memory.data(), delay_line2_memory.size(), config::sampling_frequency_hz},
+delay1_mod { delay_line1_tap_samples },
+delay2_mod { delay_line2_tap_samples },
 attr {}
 {
     const auto& def = chorus_attr::default_ctrl;
@@ -59,35 +94,71 @@ chorus::~chorus()
 
 void chorus::process(const dsp_input& in, dsp_output& out)
 {
-    std::transform(in.begin(), in.end(), out.begin(),
-    [this](auto input)
+    const uint32_t n = in.size();
+    this->process_voices(in.data(), out.data(), n);
+
+    if (this->attr.ctrl.mode == chorus_attr::controls::mode_type::deep)
     {
-        const float depth = 0.0001f + this->attr.ctrl.depth * 0.0015f;
+        arm_add_f32(out.data(), this->out2.data(), out.data(), n);
+        arm_scale_f32(out.data(), 0.7f, out.data(), n);
+    }
 
-        if (this->attr.ctrl.mode == chorus_attr::controls::mode_type::white)
-        {
-            this->unicomb1.set_delay(delay_line1_tap + this->lfo1.generate() * depth);
-            const float output = this->unicomb1.process<false, true, delay_line1_tap_samples>(input);
-            return this->attr.ctrl.mix * output + (1 - this->attr.ctrl.mix) * input;
-        }
-        else
-        {
-            this->unicomb1.set_delay(delay_line1_tap + this->lfo1.generate() * depth);
-            this->unicomb2.set_delay(delay_line2_tap + this->lfo2.generate() * depth);
-            const float out1 = this->unicomb1.process<false, true, 0>(input);
-            const float out2 = this->unicomb2.process<false, true, 0>(input);
-            const float output = 0.7f * (out1 + out2);
-            return this->attr.ctrl.mix * output + (1 - this->attr.ctrl.mix) * input;
-        }
+    /* Mix */
+    std::transform(in.begin(), in.end(), out.begin(), out.begin(),
+    [this](auto input, auto output)
+    {
+        return this->attr.ctrl.mix * output + (1 - this->attr.ctrl.mix) * input;
     }
     );
 }
 
+void chorus::process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r)
+{
+    /* Voices are fed with mid signal, dry signal keeps its stereo image */
+    const uint32_t n = in_l.size();
+    const float *in = in_l.data();
+    if (&in_l != &in_r)
+    {
+        for (uint32_t i = 0; i < n; i++)
+            this->input[i] = 0.5f * (in_l[i] + in_r[i]);
+
+        in = this->input.data();
+    }
+
+    this->process_voices(in, out_l.data(), n);
+
+    if (this->attr.ctrl.mode == chorus_attr::controls::mode_type::white)
+    {
+        /* Right channel gets inverted wet part of single voice */
+        for (uint32_t i = 0; i < n; i++)
+            out_r[i] = 2 * white_blend * in[i] - out_l[i];
+    }
+    else
+    {
+        /* Each voice goes to its own channel */
+        arm_copy_f32(this->out2.data(), out_r.data(), n);
+    }
+
+    /* Mix */
+    const float mix = this->attr.ctrl.mix;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out_l[i] = mix * out_l[i] + (1 - mix) * in_l[i];
+        out_r[i] = mix * out_r[i] + (1 - mix) * in_r[i];
+    }
+}
+
 const effect_specific_attr chorus::get_specific_attributes(void) const
 {
     return this->attr;
 }
 
+uint32_t chorus::tail_length(void) const
+{
+    /* Longest modulated delay line */
+    return std::max(delay_line1_memory.size(), delay_line2_memory.size());
+}
+
 void chorus::set_depth(float depth)
 {
     depth = std::clamp(depth, 0.0f, 1.0f);
@@ -142,7 +213,7 @@ void chorus::set_mode(chorus_attr::controls::mode_type mode)
 
     if (mode == chorus_attr::controls::mode_type::white)
     {
-        this->unicomb1.set_blend(0.7f);
+        this->unicomb1.set_blend(white_blend);
         this->unicomb1.set_feedback(-0.7f);
     }
     else if (mode == chorus_attr::controls::mode_type::deep)
@@ -10,6 +10,8 @@
 
 #include "app/model/effect_interface.hpp"
 
+#include <array>
+
 #include <libs/audio_dsp.hpp>
 
 namespace mfx
@@ -22,7 +24,10 @@ public:
     virtual ~chorus();
 
     void process(const dsp_input &in, dsp_output &out) override;
+    void process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r) override;
+    bool is_stereo(void) const override { return true; };
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
 
     void set_depth(float depth);
     void set_rate(float rate);
@@ -31,9 +36,15 @@ public:
     void set_mode(chorus_attr::controls::mode_type mode);
 
 private:
-    libs::adsp::oscillator lfo1, lfo2;
+    void process_voices(const float *in, float *out, uint32_t n);
+
+    libs::adsp::wavetable_oscillator lfo1, lfo2;
     libs::adsp::unicomb unicomb1, unicomb2;
 
+    /* Modulation targets (evaluated at control rate) */
+    libs::adsp::control_rate_modulator<config::control_rate_period> delay1_mod, delay2_mod;
+    std::array<float, config::dsp_max_buffer_size> input, delay1, delay2, out2;
+
     chorus_attr attr {0};
 };
 
@@ -0,0 +1,491 @@
+/*
+ * dsp_pipeline.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "dsp_pipeline.hpp"
+
+#ifdef DUAL_CORE_APP
+
+#include <atomic>
+#include <algorithm>
+#include <utility>
+
+#include <hal_system.hpp>
+#include <hal/hal_ipc.hpp>
+
+#include "effect_catalog.hpp"
+#include "effect_graph.hpp"
+
+using namespace mfx;
+
+//-----------------------------------------------------------------------------
+/* helpers */
+
+namespace
+{
+    static_assert(sizeof(dsp_pipeline_shared) <= sizeof(hal::ipc::ipc_struct.dsp_pipeline),
+                  "DSP pipeline does not fit into shared memory");
+
+    dsp_pipeline_shared& shared(void)
+    {
+        return *reinterpret_cast<dsp_pipeline_shared*>(hal::ipc::ipc_struct.dsp_pipeline);
+    }
+
+    uint32_t cycles_to_ns(uint32_t cycles)
+    {
+        return static_cast<uint64_t>(cycles) * 1000000000ull / hal::system::system_clock;
+    }
+
+    /* Exponential moving average with 1/16 weight of new value */
+    void update_average(volatile uint32_t &avg, uint32_t value)
+    {
+        const uint32_t current = avg;
+        avg = current + static_cast<int32_t>(value - current) / 16;
+    }
+
+    void write_block(const dsp_buffer &left, const dsp_buffer &right, bool stereo, dsp_pipeline_shared::block &b)
+    {
+        b.samples = left.size();
+        b.stereo = stereo;
+        std::copy(left.begin(), left.end(), b.left.begin());
+        if (stereo)
+            std::copy(right.begin(), right.end(), b.right.begin());
+    }
+
+    bool read_block(const dsp_pipeline_shared::block &b, dsp_buffer &left, dsp_buffer &right)
+    {
+        std::copy(b.left.begin(), b.left.begin() + left.size(), left.begin());
+        if (b.stereo)
+            std::copy(b.right.begin(), b.right.begin() + right.size(), right.begin());
+
+        return b.stereo;
+    }
+}
+
+//-----------------------------------------------------------------------------
+/* private */
+
+void dsp_pipeline_stage::dispatch(const event &e)
+{
+    std::visit([this](auto &&e) { this->event_handler(e); }, e.data);
+}
+
+void dsp_pipeline_stage::event_handler(const dsp_pipeline_stage_events::process_block &e)
+{
+    /* Cleared before reading shared memory, so notification sent meanwhile is not lost */
+    this->wake_pending = false;
+
+    auto &s = shared();
+
+    if (s.generation != this->generation)
+        this->request_rebuild();
+    else if (s.controls_generation != this->controls_generation)
+        this->apply_controls();
+
+    /* Only the latest block is processed (older one would be late anyway) */
+    const uint32_t sequence = s.posted;
+    if (sequence == s.done)
+        return;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    this->process(s.in[sequence % 2], s.out[sequence % 2]);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.done = sequence;
+}
+
+void dsp_pipeline_stage::event_handler(const dsp_pipeline_stage_events::effects_built &e)
+{
+    dsp_pipeline_builder_events::built b;
+    while (this->built_effects.pop(b))
+    {
+        this->build_pending = false;
+        this->rebuild(b);
+    }
+}
+
+void dsp_pipeline_stage::request_rebuild(void)
+{
+    /* Result of build is checked against the latest generation, so only one build is pending at a time */
+    if (this->build_pending)
+        return;
+
+    auto &s = shared();
+
+    hal::ipc::lock_dsp_pipeline();
+    const auto stage = s.stage;
+    const uint8_t count = s.stage_count;
+    const uint32_t generation = s.generation;
+    hal::ipc::unlock_dsp_pipeline();
+
+    /* Only effects, which are not in stage yet, are built (kept ones are moved with their state) */
+    dsp_pipeline_builder_events::build b {generation, 0, {}};
+    for (uint8_t i = 0; i < count; i++)
+    {
+        auto it = std::find_if(this->effects.begin(), this->effects.end(),
+                               [&](auto &&e) { return e->get_basic_attributes().id == stage[i].id; });
+        if (it == this->effects.end())
+            b.stage[b.count++] = stage[i];
+    }
+
+    if (b.count == 0)
+    {
+        this->rebuild({generation, 0, {}});
+        return;
+    }
+
+    this->build_pending = true;
+    this->builder.send({b});
+}
+
+void dsp_pipeline_stage::rebuild(const dsp_pipeline_builder_events::built &b)
+{
+    auto &s = shared();
+
+    hal::ipc::lock_dsp_pipeline();
+    const auto stage = s.stage;
+    const uint8_t count = s.stage_count;
+    const uint32_t generation = s.generation;
+    const uint32_t controls_generation = s.controls_generation;
+    hal::ipc::unlock_dsp_pipeline();
+
+    /* Built effects, which are not taken (e.g. stage changed meanwhile), are destroyed by builder */
+    auto instances = b.instances;
+
+    if (b.generation == generation)
+    {
+        /* New set of effects in stage order, effects are kept or taken from built ones (CM7 runs whole chain meanwhile) */
+        std::array<std::unique_ptr<effect>, dsp_pipeline_shared::max_stage_effects> next;
+        uint8_t next_count = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            std::unique_ptr<effect> instance;
+
+            auto it = std::find_if(this->effects.begin(), this->effects.end(),
+                                   [&](auto &&e) { return e && e->get_basic_attributes().id == stage[i].id; });
+            if (it != this->effects.end())
+            {
+                instance = std::move(*it);
+            }
+            else
+            {
+                auto built = std::find_if(instances.begin(), instances.begin() + b.count,
+                                          [&](auto *e) { return e && e->get_basic_attributes().id == stage[i].id; });
+                if (built != instances.begin() + b.count)
+                    instance.reset(std::exchange(*built, nullptr));
+            }
+
+            if (instance == nullptr)
+                continue;
+
+            instance->bypass(stage[i].bypassed);
+            apply_effect_controls(instance.get(), stage[i].ctrl);
+            next[next_count++] = std::move(instance);
+        }
+
+        /* Vector keeps its capacity, effects removed from stage are destroyed by builder */
+        for (auto &&effect : this->effects)
+        {
+            if (effect)
+                this->builder.send({dsp_pipeline_builder_events::destroy {effect.release()}});
+        }
+
+        this->effects.clear();
+        for (uint8_t i = 0; i < next_count; i++)
+            this->effects.push_back(std::move(next[i]));
+
+        this->generation = generation;
+        this->controls_generation = controls_generation;
+
+        std::atomic_thread_fence(std::memory_order_release);
+        s.active_generation = generation;
+    }
+
+    for (auto *instance : instances)
+    {
+        if (instance)
+            this->builder.send({dsp_pipeline_builder_events::destroy {instance}});
+    }
+
+    /* Set of effects changed again while they were being built */
+    if (generation != this->generation)
+        this->request_rebuild();
+}
+
+void dsp_pipeline_stage::apply_controls(void)
+{
+    auto &s = shared();
+
+    hal::ipc::lock_dsp_pipeline();
+    const auto stage = s.stage;
+    const uint8_t count = s.stage_count;
+    this->controls_generation = s.controls_generation;
+    hal::ipc::unlock_dsp_pipeline();
+
+    /* Set of effects is the same as in stage (otherwise generation would change), so they are in the same order */
+    for (uint8_t i = 0, j = 0; i < count && j < this->effects.size(); i++)
+    {
+        auto &effect = this->effects[j];
+        if (effect->get_basic_attributes().id != stage[i].id)
+            continue;
+
+        effect->bypass(stage[i].bypassed);
+        apply_effect_controls(effect.get(), stage[i].ctrl);
+        j++;
+    }
+}
+
+void dsp_pipeline_stage::process(dsp_pipeline_shared::block &in, dsp_pipeline_shared::block &out)
+{
+    const uint32_t block_start = hal::system::clock::cycles();
+    auto &s = shared();
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        this->dsp_left[i].resize(in.samples);
+        this->dsp_right[i].resize(in.samples);
+    }
+    this->dsp_side.resize(in.samples);
+
+    uint8_t current = 0;
+    bool stereo = read_block(in, this->dsp_left[current], this->dsp_right[current]);
+
+    for (auto &&effect : this->effects)
+    {
+        if (effect->is_bypassed())
+            continue;
+
+        const uint8_t next = current ^ 1;
+        const uint32_t effect_start = hal::system::clock::cycles();
+
+        run_effect(*effect, this->dsp_left[current], this->dsp_right[current], stereo,
+                   this->dsp_left[next], this->dsp_right[next], this->dsp_side);
+
+        const uint32_t effect_cycles = hal::system::clock::cycles() - effect_start;
+        update_average(s.effect_time_ns[static_cast<uint8_t>(effect->get_basic_attributes().id)], cycles_to_ns(effect_cycles));
+
+        stereo = stereo || effect->is_stereo();
+        current = next;
+    }
+
+    write_block(this->dsp_left[current], this->dsp_right[current], stereo, out);
+
+    update_average(s.block_time_ns, cycles_to_ns(hal::system::clock::cycles() - block_start));
+}
+
+void dsp_pipeline_builder::dispatch(const event &e)
+{
+    std::visit([this](auto &&e) { this->event_handler(e); }, e.data);
+}
+
+void dsp_pipeline_builder::event_handler(const dsp_pipeline_builder_events::build &e)
+{
+    dsp_pipeline_builder_events::built b {e.generation, e.count, {}};
+
+    for (uint8_t i = 0; i < e.count; i++)
+    {
+        auto instance = create_effect(e.stage[i].id);
+        if (instance == nullptr)
+            continue;
+
+        instance->bypass(e.stage[i].bypassed);
+        apply_effect_controls(instance.get(), e.stage[i].ctrl);
+        instance->warm_up();
+        b.instances[i] = instance.release();
+    }
+
+    this->notify(b);
+}
+
+void dsp_pipeline_builder::event_handler(const dsp_pipeline_builder_events::destroy &e)
+{
+    delete e.instance;
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+dsp_pipeline::dsp_pipeline()
+{
+    this->count = 0;
+    this->misses = 0;
+    this->streaming = false;
+    this->delayed = {};
+    this->delayed_slot = 0;
+
+    /* CM4 stage touches shared memory only after it is notified */
+    auto &s = shared();
+    s.posted = 0;
+    s.generation = 0;
+    s.controls_generation = 0;
+    s.stage_count = 0;
+    s.done = 0;
+    s.active_generation = 0;
+    s.block_time_ns = 0;
+    for (auto &&t : s.effect_time_ns)
+        t = 0;
+}
+
+void dsp_pipeline::configure(effect_iterator first, effect_iterator last)
+{
+    auto &s = shared();
+
+    std::array<effect_id, dsp_pipeline_shared::max_stage_effects> new_ids;
+    uint8_t new_count = 0;
+    for (auto it = first; it != last && new_count < new_ids.size(); ++it)
+        new_ids[new_count++] = (*it)->get_basic_attributes().id;
+
+    const bool changed = new_count != this->count || !std::equal(new_ids.begin(), new_ids.begin() + new_count, this->ids.begin());
+
+    /* Generation is changed together with effects, so CM4 never sees new effects with old generation */
+    hal::ipc::lock_dsp_pipeline();
+    for (uint8_t i = 0; i < new_count; i++, ++first)
+        s.stage[i] = {new_ids[i], (*first)->is_bypassed(), get_effect_controls(first->get())};
+    s.stage_count = new_count;
+    if (changed)
+        s.generation = s.generation + 1;
+    else
+        s.controls_generation = s.controls_generation + 1;
+    hal::ipc::unlock_dsp_pipeline();
+
+    this->ids = new_ids;
+    this->count = new_count;
+
+    hal::ipc::notify_dsp_pipeline();
+}
+
+bool dsp_pipeline::is_ready(void) const
+{
+    const auto &s = shared();
+    return this->count > 0 && s.active_generation == s.generation;
+}
+
+bool dsp_pipeline::is_configured(effect_iterator first, effect_iterator last) const
+{
+    const bool same_count = std::distance(first, last) == this->count;
+    return same_count && std::equal(first, last, this->ids.begin(),
+                                    [](auto &&effect, effect_id id) { return effect->get_basic_attributes().id == id; });
+}
+
+bool dsp_pipeline::contains(effect_id id) const
+{
+    return std::find(this->ids.begin(), this->ids.begin() + this->count, id) != this->ids.begin() + this->count;
+}
+
+bool dsp_pipeline::exchange(dsp_buffer &left, dsp_buffer &right, bool &stereo)
+{
+    auto &s = shared();
+
+    /* Input is kept, so that block missed by CM4 can be replaced by the previous one (like in delay()) */
+    write_block(left, right, stereo, this->delayed[this->delayed_slot]);
+    this->delayed_slot ^= 1;
+
+    /* Result of block posted in previous period is awaited (unless stream was paused or block was dropped) */
+    const bool awaiting = this->streaming;
+    const uint32_t awaited = s.posted;
+
+    /* Slot of new block was used two blocks ago, CM4 must be done with it */
+    const uint32_t sequence = awaited + 1;
+    this->streaming = sequence - s.done <= 2;
+    if (this->streaming)
+    {
+        write_block(left, right, stereo, s.in[sequence % 2]);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.posted = sequence;
+        hal::ipc::notify_dsp_pipeline();
+    }
+    else
+    {
+        this->misses++;
+    }
+
+    if (awaiting && static_cast<int32_t>(s.done - awaited) >= 0)
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        stereo = read_block(s.out[awaited % 2], left, right);
+        return true;
+    }
+
+    /* CM4 missed its deadline (or stream has just started), CM7 has to process rest of chain on delayed input */
+    if (awaiting)
+        this->misses++;
+
+    stereo = read_block(this->delayed[this->delayed_slot], left, right);
+    return false;
+}
+
+void dsp_pipeline::pause(void)
+{
+    this->streaming = false;
+}
+
+void dsp_pipeline::delay(dsp_buffer &left, dsp_buffer &right, bool &stereo)
+{
+    write_block(left, right, stereo, this->delayed[this->delayed_slot]);
+    this->delayed_slot ^= 1;
+    stereo = read_block(this->delayed[this->delayed_slot], left, right);
+}
+
+void dsp_pipeline::reset_delay(void)
+{
+    this->delayed = {};
+}
+
+uint8_t dsp_pipeline::get_load(uint32_t block_size) const
+{
+    if (!this->is_ready())
+        return 0;
+
+    const uint64_t block_period_ns = 1000000000ull * block_size / config::sampling_frequency_hz;
+    return std::min<uint64_t>(100, 100ull * shared().block_time_ns / block_period_ns);
+}
+
+uint32_t dsp_pipeline::get_effect_cycles(effect_id id) const
+{
+    const uint64_t ns = shared().effect_time_ns[static_cast<uint8_t>(id)];
+    return ns * hal::system::system_clock / 1000000000ull;
+}
+
+dsp_pipeline_stage::dsp_pipeline_stage() : actor("dsp_pipeline", configTASK_PRIO_REALTIME, 4096, 4)
+{
+    this->generation = 0;
+    this->controls_generation = 0;
+    this->build_pending = false;
+    this->effects.reserve(dsp_pipeline_shared::max_stage_effects);
+
+    this->builder.attach([this](dsp_pipeline_builder_events::built b)
+    {
+        /* Called from builder thread */
+        while (!this->built_effects.push(b))
+            vTaskDelay(1);
+
+        static const event e{ dsp_pipeline_stage_events::effects_built {}, true };
+        this->send(e);
+    });
+
+    hal::ipc::init_dsp_pipeline(
+    [this]()
+    {
+        /* Wake-ups are not queued, handler always works with the latest state of shared memory */
+        if (!this->wake_pending.exchange(true))
+        {
+            static const event e{ dsp_pipeline_stage_events::process_block {}, true };
+            this->send(e);
+        }
+    });
+}
+
+dsp_pipeline_stage::~dsp_pipeline_stage()
+{
+
+}
+
+dsp_pipeline_builder::dsp_pipeline_builder() :
+actor("dsp_pipeline_builder", configTASK_PRIO_LOW, 4096, dsp_pipeline_builder_event_slots)
+{
+
+}
+
+#endif /* DUAL_CORE_APP */
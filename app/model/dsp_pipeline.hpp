@@ -0,0 +1,228 @@
+/*
+ * dsp_pipeline.hpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef MODEL_DSP_PIPELINE_HPP_
+#define MODEL_DSP_PIPELINE_HPP_
+
+#ifdef DUAL_CORE_APP
+
+#include "effect_interface.hpp"
+
+#include <middlewares/actor.hpp>
+#include <libs/fast_queue.hpp>
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <variant>
+#include <atomic>
+
+namespace mfx
+{
+
+/*
+ * Memory shared by cores. Block n is passed through slot n % 2, so CM7 fills one slot while CM4 processes the other.
+ * Each field has single writer, data is published by sequence numbers (written after data, behind memory barrier).
+ */
+struct dsp_pipeline_shared
+{
+    constexpr static uint8_t max_stage_effects {8};
+
+    struct block
+    {
+        uint16_t samples;
+        bool stereo;
+        std::array<float, config::dsp_max_buffer_size> left, right;
+    };
+
+    struct stage_effect
+    {
+        effect_id id;
+        bool bypassed;
+        effect_controls ctrl;
+    };
+
+    /* Written by CM7 (stage effects are guarded by HSEM) */
+    volatile uint32_t posted; // Sequence number of last posted block
+    volatile uint32_t generation; // Incremented when set of stage effects changes
+    volatile uint32_t controls_generation; // Incremented when controls or bypass of stage effects change
+    uint8_t stage_count;
+    std::array<stage_effect, max_stage_effects> stage;
+    std::array<block, 2> in;
+
+    /* Written by CM4 */
+    volatile uint32_t done; // Sequence number of last processed block
+    volatile uint32_t active_generation; // Set of effects run by CM4 stage
+    volatile uint32_t block_time_ns; // Average processing time of block
+    std::array<volatile uint32_t, static_cast<uint8_t>(effect_id::_count)> effect_time_ns; // Average time of each effect
+    std::array<block, 2> out;
+};
+
+/* Effects which run on CM4 (others need aux input, report to UI from processing or are not built for CM4) */
+constexpr bool is_offloadable(effect_id id)
+{
+    return id != effect_id::tuner && id != effect_id::vocoder
+#ifndef CFG_DISABLE_NEURAL_AMP_MODELER
+           && id != effect_id::neural_amp_modeler
+#endif
+           ;
+}
+
+/*
+ * CM7 side of pipeline: hands output of CM7 part of chain to CM4 stage & takes back result of previous block
+ * (pipelining adds one block of latency, but both parts of chain are processed at the same time).
+ */
+class dsp_pipeline
+{
+public:
+    typedef std::vector<std::unique_ptr<effect>>::const_iterator effect_iterator;
+
+    dsp_pipeline();
+
+    /* Effects of CM4 stage are mirrored from CM7 instances, which keep controls & bypass state of all effects */
+    void configure(effect_iterator first, effect_iterator last);
+
+    /* CM4 stage runs current set of effects (until then, CM7 has to process whole chain) */
+    bool is_ready(void) const;
+
+    /* CM4 stage is configured with given effects (in the same order) or contains given effect */
+    bool is_configured(effect_iterator first, effect_iterator last) const;
+    bool contains(effect_id id) const;
+    bool is_empty(void) const { return this->count == 0; };
+
+    /*
+     * Posts block to CM4 & replaces it with result of block posted in previous period. Returns false if CM4 missed
+     * its deadline, then block is replaced by the previous input (so that rest of chain can be processed by CM7
+     * with the same latency). Must be called for each block, pause() is called for blocks without it.
+     */
+    bool exchange(dsp_buffer &left, dsp_buffer &right, bool &stereo);
+    void pause(void);
+
+    /* Block processed only by CM7 is replaced by the one from previous period, so latency is the same as via CM4 */
+    void delay(dsp_buffer &left, dsp_buffer &right, bool &stereo);
+    void reset_delay(void);
+
+    /* Load of CM4 (percent of block time) & average time of effect on CM4 in CM7 cycles (0 if not measured) */
+    uint8_t get_load(uint32_t block_size) const;
+    uint32_t get_effect_cycles(effect_id id) const;
+    uint32_t get_misses(void) const { return this->misses; };
+
+private:
+    std::array<effect_id, dsp_pipeline_shared::max_stage_effects> ids;
+    uint8_t count;
+    uint32_t misses;
+    bool streaming;
+    std::array<dsp_pipeline_shared::block, 2> delayed;
+    uint8_t delayed_slot;
+};
+
+namespace dsp_pipeline_builder_events
+{
+
+struct build
+{
+    uint32_t generation;
+    uint8_t count;
+    std::array<dsp_pipeline_shared::stage_effect, dsp_pipeline_shared::max_stage_effects> stage; // Effects to create
+};
+
+struct destroy
+{
+    effect *instance;
+};
+
+using incoming = std::variant
+<
+    build,
+    destroy
+>;
+
+/* Effects handed over by builder (in order of build request, null if effect could not be created) */
+struct built
+{
+    uint32_t generation;
+    uint8_t count;
+    std::array<effect*, dsp_pipeline_shared::max_stage_effects> instances;
+};
+
+}
+
+/* Build request & destruction of every stage effect (old & new set) can be pending at the same time */
+constexpr inline uint32_t dsp_pipeline_builder_event_slots {2 * dsp_pipeline_shared::max_stage_effects + 1};
+
+/* Low priority worker on CM4, which constructs & destroys effects, so that realtime stage never allocates */
+class dsp_pipeline_builder : public middlewares::actor<dsp_pipeline_builder_events::incoming,
+                                                       dsp_pipeline_builder_events::built,
+                                                       dsp_pipeline_builder_event_slots>
+{
+public:
+    dsp_pipeline_builder();
+
+private:
+    void dispatch(const event &e) override;
+
+    void event_handler(const dsp_pipeline_builder_events::build &e);
+    void event_handler(const dsp_pipeline_builder_events::destroy &e);
+};
+
+namespace dsp_pipeline_stage_events
+{
+
+struct process_block
+{
+    /* Sent from IPC interrupt when CM7 posted block or changed configuration */
+};
+
+struct effects_built
+{
+    /* Sent by builder when new effects are ready to be taken from handoff queue */
+};
+
+using incoming = std::variant
+<
+    process_block,
+    effects_built
+>;
+
+}
+
+/* CM4 side of pipeline: runs last effects of chain on blocks posted by CM7 */
+class dsp_pipeline_stage : public middlewares::actor<dsp_pipeline_stage_events::incoming>
+{
+public:
+    dsp_pipeline_stage();
+    ~dsp_pipeline_stage();
+
+private:
+    void dispatch(const event &e) override;
+    void event_handler(const dsp_pipeline_stage_events::process_block &e);
+    void event_handler(const dsp_pipeline_stage_events::effects_built &e);
+
+    void request_rebuild(void);
+    void rebuild(const dsp_pipeline_builder_events::built &b);
+    void apply_controls(void);
+    void process(dsp_pipeline_shared::block &in, dsp_pipeline_shared::block &out);
+
+    std::atomic<bool> wake_pending {false};
+    std::vector<std::unique_ptr<effect>> effects;
+    uint32_t generation;
+    uint32_t controls_generation;
+
+    /* New set of effects is built by low priority worker, old set is processed meanwhile */
+    dsp_pipeline_builder builder;
+    libs::fast_queue<dsp_pipeline_builder_events::built, 2> built_effects;
+    bool build_pending;
+
+    std::array<dsp_buffer, 2> dsp_left, dsp_right;
+    dsp_buffer dsp_side;
+};
+
+}
+
+#endif /* DUAL_CORE_APP */
+
+#endif /* MODEL_DSP_PIPELINE_HPP_ */
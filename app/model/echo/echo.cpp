@@ -9,6 +9,7 @@
 
 #include <array>
 #include <algorithm>
+#include <cmath>
 
 using namespace mfx;
 
@@ -47,12 +48,37 @@ echo::~echo()
 
 void echo::process(const dsp_input& in, dsp_output& out)
 {
-    std::transform(in.begin(), in.end(), out.begin(),
-    [this](auto input)
+    /* Minimal delay time is much longer than block, so whole block is processed by vector operations */
+    this->unicomb.process<true>(in.data(), out.data(), in.size());
+}
+
+void echo::process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r)
+{
+    /* Delay line is fed with mid signal, left channel repeats at multiples of time & right one halfway between them */
+    const uint32_t n = in_l.size();
+    const float *in = in_l.data();
+    if (&in_l != &in_r)
     {
-        return this->unicomb.process<true>(input);
+        for (uint32_t i = 0; i < n; i++)
+            this->input[i] = 0.5f * (in_l[i] + in_r[i]);
+
+        in = this->input.data();
+    }
+
+    this->unicomb.process<true>(in, out_l.data(), n);
+
+    /* Samples written to delay line in this block, shifted by half of time */
+    const uint32_t half_time = 0.5f * this->attr.ctrl.time * config::sampling_frequency_hz;
+    this->unicomb.read(out_r.data(), n, half_time + n);
+
+    /* Output of unicomb is 'bl * in + wet', repeats of right channel are scaled like the first repeat of left one */
+    const float bl = this->unicomb.get_blend();
+    const float wet_r = this->unicomb.get_feedforward() + bl * this->unicomb.get_feedback();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out_l[i] += bl * (in_l[i] - in[i]);
+        out_r[i] = wet_r * out_r[i] + bl * in_r[i];
     }
-    );
 }
 
 const effect_specific_attr echo::get_specific_attributes(void) const
@@ -60,6 +86,16 @@ const effect_specific_attr echo::get_specific_attributes(void) const
     return this->attr;
 }
 
+uint32_t echo::tail_length(void) const
+{
+    /* Repeats decay by feedback gain on each trip through delay line, until -120dB */
+    uint32_t trips = 1;
+    if (this->attr.ctrl.mode == echo_attr::controls::mode_type::echo && this->attr.ctrl.feedback > 0)
+        trips += std::ceil(std::log(1e-6f) / std::log(this->attr.ctrl.feedback));
+
+    return trips * this->attr.ctrl.time * config::sampling_frequency_hz;
+}
+
 void echo::set_blur(float blur)
 {
     blur = std::clamp(blur, 0.0f, 1.0f);
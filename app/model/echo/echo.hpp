@@ -10,6 +10,8 @@
 
 #include "app/model/effect_interface.hpp"
 
+#include <array>
+
 #include <libs/audio_dsp.hpp>
 
 namespace mfx
@@ -22,7 +24,10 @@ public:
     virtual ~echo();
 
     void process(const dsp_input &in, dsp_output &out) override;
+    void process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r) override;
+    bool is_stereo(void) const override { return true; };
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
 
     void set_blur(float blur);
     void set_time(float time);
@@ -31,6 +36,7 @@ public:
 
 private:
     libs::adsp::unicomb unicomb;
+    std::array<float, config::dsp_max_buffer_size> input;
 
     echo_attr attr {0};
 };
@@ -0,0 +1,251 @@
+/*
+ * effect_catalog.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "effect_catalog.hpp"
+
+#include <array>
+
+#include "app/model/tuner/tuner.hpp"
+#include "app/model/tremolo/tremolo.hpp"
+#include "app/model/echo/echo.hpp"
+#include "app/model/chorus/chorus.hpp"
+#include "app/model/reverb/reverb.hpp"
+#include "app/model/overdrive/overdrive.hpp"
+#include "app/model/cabinet_sim/cabinet_sim.hpp"
+#include "app/model/vocoder/vocoder.hpp"
+#include "app/model/phaser/phaser.hpp"
+#include "app/model/amp_sim/amp_sim.hpp"
+
+/* NAM is built only for core running the whole chain (second core of dual-core app runs only DSP pipeline stage) */
+#if !defined(CFG_DISABLE_NEURAL_AMP_MODELER) && !(defined(DUAL_CORE_APP) && defined(CORE_CM4))
+#define EFFECT_CATALOG_NAM
+#include "app/model/nam/nam.hpp"
+#endif
+
+using namespace mfx;
+
+//-----------------------------------------------------------------------------
+/* helpers */
+
+namespace
+{
+    bool apply_controls(effect *e, const tuner_attr::controls &ctrl, controls_mask changed)
+    {
+        auto tuner_effect = static_cast<tuner*>(e);
+
+        if (changed & ctrl.mute_field)
+            tuner_effect->set_mute_mode(ctrl.mute);
+        if (changed & ctrl.a4_tuning_field)
+            tuner_effect->set_a4_tuning(ctrl.a4_tuning);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const tremolo_attr::controls &ctrl, controls_mask changed)
+    {
+        auto tremolo_effect = static_cast<tremolo*>(e);
+
+        if (changed & ctrl.rate_field)
+            tremolo_effect->set_rate(ctrl.rate);
+        if (changed & ctrl.depth_field)
+            tremolo_effect->set_depth(ctrl.depth);
+        if (changed & ctrl.shape_field)
+            tremolo_effect->set_shape(ctrl.shape);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const echo_attr::controls &ctrl, controls_mask changed)
+    {
+        auto echo_effect = static_cast<echo*>(e);
+
+        if (changed & ctrl.mode_field)
+            echo_effect->set_mode(ctrl.mode);
+        if (changed & ctrl.blur_field)
+            echo_effect->set_blur(ctrl.blur);
+        if (changed & ctrl.time_field)
+            echo_effect->set_time(ctrl.time);
+        if (changed & ctrl.feedback_field)
+            echo_effect->set_feedback(ctrl.feedback);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const chorus_attr::controls &ctrl, controls_mask changed)
+    {
+        auto chorus_effect = static_cast<chorus*>(e);
+
+        if (changed & ctrl.depth_field)
+            chorus_effect->set_depth(ctrl.depth);
+        if (changed & ctrl.rate_field)
+            chorus_effect->set_rate(ctrl.rate);
+        if (changed & ctrl.tone_field)
+            chorus_effect->set_tone(ctrl.tone);
+        if (changed & ctrl.mix_field)
+            chorus_effect->set_mix(ctrl.mix);
+        if (changed & ctrl.mode_field)
+            chorus_effect->set_mode(ctrl.mode);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const reverb_attr::controls &ctrl, controls_mask changed)
+    {
+        auto reverb_effect = static_cast<reverb*>(e);
+
+        if (changed & ctrl.bandwidth_field)
+            reverb_effect->set_bandwidth(ctrl.bandwidth);
+        if (changed & ctrl.damping_field)
+            reverb_effect->set_damping(ctrl.damping);
+        if (changed & ctrl.decay_field)
+            reverb_effect->set_decay(ctrl.decay);
+        if (changed & ctrl.mode_field)
+            reverb_effect->set_mode(ctrl.mode);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const overdrive_attr::controls &ctrl, controls_mask changed)
+    {
+        auto overdrive_effect = static_cast<overdrive*>(e);
+
+        if (changed & ctrl.mode_field)
+            overdrive_effect->set_mode(ctrl.mode);
+        if (changed & ctrl.high_field)
+            overdrive_effect->set_high(ctrl.high);
+        if (changed & ctrl.low_field)
+            overdrive_effect->set_low(ctrl.low);
+        if (changed & ctrl.gain_field)
+            overdrive_effect->set_gain(ctrl.gain);
+        if (changed & ctrl.mix_field)
+            overdrive_effect->set_mix(ctrl.mix);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const cabinet_sim_attr::controls &ctrl, controls_mask changed)
+    {
+        auto cab_sim_effect = static_cast<cabinet_sim*>(e);
+
+        if (changed & ctrl.ir_idx_field)
+            cab_sim_effect->set_ir(ctrl.ir_idx);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const vocoder_attr::controls &ctrl, controls_mask changed)
+    {
+        auto vocoder_effect = static_cast<vocoder*>(e);
+
+        /* Internal structure of effect changes with mode */
+        bool structure_changed = false;
+        if (changed & ctrl.mode_field)
+        {
+            structure_changed = std::get<vocoder_attr>(vocoder_effect->get_specific_attributes()).ctrl.mode != ctrl.mode;
+            vocoder_effect->set_mode(ctrl.mode);
+        }
+        if (changed & ctrl.hold_field)
+            vocoder_effect->hold(ctrl.hold);
+        if (changed & ctrl.tone_field)
+            vocoder_effect->set_tone(ctrl.tone);
+        if (changed & ctrl.clarity_field)
+            vocoder_effect->set_clarity(ctrl.clarity);
+        if (changed & ctrl.bands_field)
+            vocoder_effect->set_bands(ctrl.bands);
+
+        return structure_changed;
+    }
+
+    bool apply_controls(effect *e, const phaser_attr::controls &ctrl, controls_mask changed)
+    {
+        auto phaser_effect = static_cast<phaser*>(e);
+
+        if (changed & ctrl.rate_field)
+            phaser_effect->set_rate(ctrl.rate);
+        if (changed & ctrl.depth_field)
+            phaser_effect->set_depth(ctrl.depth);
+        if (changed & ctrl.contour_field)
+            phaser_effect->set_contour(ctrl.contour);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const amp_sim_attr::controls &ctrl, controls_mask changed)
+    {
+        auto amp_sim_effect = static_cast<amp_sim*>(e);
+
+        if (changed & ctrl.mode_field)
+            amp_sim_effect->set_mode(ctrl.mode);
+        if (changed & ctrl.input_field)
+            amp_sim_effect->set_input(ctrl.input);
+        if (changed & ctrl.drive_field)
+            amp_sim_effect->set_drive(ctrl.drive);
+        if (changed & ctrl.compression_field)
+            amp_sim_effect->set_compression(ctrl.compression);
+
+        /* Tone stack is set at once (one filter design for all bands) */
+        if (changed & (ctrl.bass_field | ctrl.mids_field | ctrl.treb_field))
+            amp_sim_effect->set_tone_stack(ctrl.bass, ctrl.mids, ctrl.treb);
+
+        return false;
+    }
+
+    bool apply_controls(effect *e, const neural_amp_modeler_attr::controls &ctrl, controls_mask changed)
+    {
+#ifdef EFFECT_CATALOG_NAM
+        auto nam_effect = static_cast<neural_amp_modeler*>(e);
+
+        if (changed & ctrl.model_idx_field)
+            nam_effect->set_model(ctrl.model_idx);
+        if (changed & ctrl.in_vol_field)
+            nam_effect->set_input_volume(ctrl.in_vol);
+        if (changed & ctrl.out_vol_field)
+            nam_effect->set_output_volume(ctrl.out_vol);
+#endif
+
+        return false;
+    }
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+std::unique_ptr<effect> mfx::create_effect(effect_id id)
+{
+    constexpr std::array<std::unique_ptr<effect>(*)(), static_cast<uint8_t>(effect_id::_count)> constructors
+    {{
+        []() -> std::unique_ptr<effect> { return std::make_unique<tuner>();              },
+        []() -> std::unique_ptr<effect> { return std::make_unique<tremolo>();            },
+        []() -> std::unique_ptr<effect> { return std::make_unique<echo>();               },
+        []() -> std::unique_ptr<effect> { return std::make_unique<chorus>();             },
+        []() -> std::unique_ptr<effect> { return std::make_unique<reverb>();             },
+        []() -> std::unique_ptr<effect> { return std::make_unique<overdrive>();          },
+        []() -> std::unique_ptr<effect> { return std::make_unique<cabinet_sim>();        },
+        []() -> std::unique_ptr<effect> { return std::make_unique<vocoder>();            },
+        []() -> std::unique_ptr<effect> { return std::make_unique<phaser>();             },
+        []() -> std::unique_ptr<effect> { return std::make_unique<amp_sim>();            },
+#ifdef EFFECT_CATALOG_NAM
+        []() -> std::unique_ptr<effect> { return std::make_unique<neural_amp_modeler>(); }
+#elif !defined(CFG_DISABLE_NEURAL_AMP_MODELER)
+        nullptr
+#endif
+    }};
+
+    const auto constructor = constructors.at(static_cast<uint8_t>(id));
+    return constructor ? constructor() : nullptr;
+}
+
+bool mfx::apply_effect_controls(effect *e, const effect_controls &ctrl, controls_mask changed)
+{
+    return std::visit([e, changed](auto &&ctrl) { return apply_controls(e, ctrl, changed); }, ctrl);
+}
+
+effect_controls mfx::get_effect_controls(const effect *e)
+{
+    return std::visit([](auto &&attr) -> effect_controls { return attr.ctrl; }, e->get_specific_attributes());
+}
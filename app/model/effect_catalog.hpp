@@ -0,0 +1,32 @@
+/*
+ * effect_catalog.hpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef MODEL_EFFECT_CATALOG_HPP_
+#define MODEL_EFFECT_CATALOG_HPP_
+
+#include "effect_interface.hpp"
+
+#include <memory>
+
+namespace mfx
+{
+
+/* Constructs effect of given ID, returns nullptr if effect is not built for this core */
+std::unique_ptr<effect> create_effect(effect_id id);
+
+/*
+ * Controls are applied to given instance (also to one which is not in chain yet), only fields marked in 'changed'
+ * are set. Returns true if internal structure changed.
+ */
+bool apply_effect_controls(effect *e, const effect_controls &ctrl, controls_mask changed = all_controls);
+
+/* Current controls of effect */
+effect_controls get_effect_controls(const effect *e);
+
+}
+
+#endif /* MODEL_EFFECT_CATALOG_HPP_ */
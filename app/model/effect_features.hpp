@@ -66,6 +66,10 @@ struct effect_attr
 //-----------------------------------------------------------------------------
 /* Effect specific attributes */
 
+/* Bitmask of changed fields of effect controls (bits of fields are defined by each controls structure) */
+typedef uint32_t controls_mask;
+constexpr inline controls_mask all_controls {0xFFFFFFFF};
+
 struct tuner_attr
 {
     struct controls
@@ -73,6 +77,8 @@ struct tuner_attr
         bool mute; // Mute tuning mode: true - enabled, false - disabled
         unsigned a4_tuning; // Reference frequency for A4 in Hz, range: [410, 480]
         //enum class input_source {jack, mic} input; // Input source
+
+        enum field : controls_mask { mute_field = 1 << 0, a4_tuning_field = 1 << 1 };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -97,6 +103,8 @@ struct tremolo_attr
         float rate; // LFO frequency in Hz, range: [1, 20]
         float depth; // Effect depth, range: [0, 0.5]
         enum class shape_type {sine, square} shape; // LFO shape
+
+        enum field : controls_mask { rate_field = 1 << 0, depth_field = 1 << 1, shape_field = 1 << 2 };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -115,6 +123,14 @@ struct echo_attr
         float time; // Delay time, range: [0.05, 1.0]
         float feedback; // Feedback, range: [0, 0.9]
         enum class mode_type {delay, echo} mode; // Mode of effect
+
+        enum field : controls_mask
+        {
+            blur_field = 1 << 0,
+            time_field = 1 << 1,
+            feedback_field = 1 << 2,
+            mode_field = 1 << 3
+        };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -135,6 +151,15 @@ struct chorus_attr
         float tone; // Tone, range: [0, 1.0]
         float mix; // Wet/dry mix, range: [0, 1.0]
         enum class mode_type {white, deep} mode; // Mode of effect
+
+        enum field : controls_mask
+        {
+            depth_field = 1 << 0,
+            rate_field = 1 << 1,
+            tone_field = 1 << 2,
+            mix_field = 1 << 3,
+            mode_field = 1 << 4
+        };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -155,6 +180,14 @@ struct reverb_attr
         float damping; // Tank LPFs rate, range: [0, 1.0]
         float decay; // Reverb time, range: [0, 0.99]
         enum class mode_type {plate, mod} mode; // Mode of effect
+
+        enum field : controls_mask
+        {
+            bandwidth_field = 1 << 0,
+            damping_field = 1 << 1,
+            decay_field = 1 << 2,
+            mode_field = 1 << 3
+        };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -175,6 +208,15 @@ struct overdrive_attr
         float high; // Low pass filter cutoff, range [0, 1.0]
         float mix; // Wet/dry mix, range: [0, 1.0]
         enum class mode_type {soft, hard} mode; // Clip mode
+
+        enum field : controls_mask
+        {
+            low_field = 1 << 0,
+            gain_field = 1 << 1,
+            high_field = 1 << 2,
+            mix_field = 1 << 3,
+            mode_field = 1 << 4
+        };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -192,7 +234,9 @@ struct cabinet_sim_attr
     struct controls
     {
         uint8_t ir_idx; // Currently selected IR index
-        enum class resolution {standart = 1024, high = 2048} ir_res; // IR resolution in samples
+        enum class resolution {low = 512, standart = 1024, high = 2048} ir_res; // IR resolution in samples
+
+        enum field : controls_mask { ir_idx_field = 1 << 0, ir_res_field = 1 << 1 };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -213,6 +257,15 @@ struct vocoder_attr
         float tone; // Tone (HP filter cutoff), range: [0, 1.0]
         bool hold; // Holds modulator envelope, true/false
         enum class mode_type {vintage, modern} mode; // Vocoder type, IIR bandpass filters or FFT
+
+        enum field : controls_mask
+        {
+            bands_field = 1 << 0,
+            clarity_field = 1 << 1,
+            tone_field = 1 << 2,
+            hold_field = 1 << 3,
+            mode_field = 1 << 4
+        };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -234,6 +287,8 @@ struct phaser_attr
         float rate; // LFO frequency in Hz/10, range: [0.01, 1]
         float depth; // LFO modulation depth, range: [0, 1]
         enum class contour_mode {off, on} contour; // Contour enabled/disabled
+
+        enum field : controls_mask { rate_field = 1 << 0, depth_field = 1 << 1, contour_field = 1 << 2 };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -255,6 +310,17 @@ struct amp_sim_attr
         float mids; // Tone stack: mids, range [0, 1]
         float treb; // Tone stack: treble, range [0, 1]
         enum class mode_type {logain, higain} mode; // Amp overall gain: low/high
+
+        enum field : controls_mask
+        {
+            input_field = 1 << 0,
+            drive_field = 1 << 1,
+            compression_field = 1 << 2,
+            bass_field = 1 << 3,
+            mids_field = 1 << 4,
+            treb_field = 1 << 5,
+            mode_field = 1 << 6
+        };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -276,6 +342,8 @@ struct neural_amp_modeler_attr
         uint8_t model_idx; // Currently selected model index
         float in_vol; // Input volume, range: [0, 1]
         float out_vol; // Output volume, range: [0, 1]
+
+        enum field : controls_mask { model_idx_field = 1 << 0, in_vol_field = 1 << 1, out_vol_field = 1 << 2 };
     } ctrl;
 
     static constexpr controls default_ctrl
@@ -0,0 +1,213 @@
+/*
+ * effect_graph.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "effect_graph.hpp"
+
+#include <algorithm>
+
+#include <cmsis/dsp/arm_math.h>
+
+using namespace mfx;
+
+//-----------------------------------------------------------------------------
+/* helpers */
+
+namespace
+{
+    /* Values are outputs of nodes, graph input is stored after them */
+    constexpr uint8_t input_value = effect_graph::max_nodes;
+
+    uint8_t value_of(uint8_t idx)
+    {
+        return idx == effect_graph::graph_input ? input_value : idx;
+    }
+
+    uint8_t inputs_of(const route_node &n)
+    {
+        return n.type == route_node::node_type::mix ? 2 : 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+void mfx::run_effect(effect &e, const dsp_buffer &in_l, const dsp_buffer &in_r, bool input_stereo,
+                     dsp_buffer &out_l, dsp_buffer &out_r, dsp_buffer &side)
+{
+    if (e.is_stereo())
+    {
+        e.process_stereo(in_l, input_stereo ? in_r : in_l, out_l, out_r);
+    }
+    else if (!input_stereo)
+    {
+        e.process(in_l, out_l);
+    }
+    else
+    {
+        /* Mid is processed in right output buffer, then side is added back to processed mid */
+        const uint32_t n = in_l.size();
+        for (uint32_t i = 0; i < n; i++)
+        {
+            side[i] = 0.5f * (in_l[i] - in_r[i]);
+            out_r[i] = 0.5f * (in_l[i] + in_r[i]);
+        }
+
+        e.process(out_r, out_l);
+        arm_sub_f32(out_l.data(), side.data(), out_r.data(), n);
+        arm_add_f32(out_l.data(), side.data(), out_l.data(), n);
+    }
+}
+
+bool effect_graph::compile(const route_node *nodes, uint8_t count, uint8_t output, const lookup_t &lookup)
+{
+    if (count > max_nodes || (output >= count && output != graph_input))
+        return false;
+
+    for (uint8_t n = 0; n < count; n++)
+    {
+        for (uint8_t i = 0; i < inputs_of(nodes[n]); i++)
+        {
+            if (nodes[n].in[i] >= count && nodes[n].in[i] != graph_input)
+                return false;
+        }
+    }
+
+    /*
+     * Execution order: post-order walk from output, so inputs are computed right before they are consumed
+     * (keeps few values alive at once). Nodes not contributing to output are dropped, revisiting node
+     * which is still being walked means cycle.
+     */
+    std::array<uint8_t, max_nodes> order;
+    uint8_t ordered = 0;
+    uint32_t walking = 0;
+    uint32_t walked = 0;
+
+    auto walk = [&](auto &self, uint8_t n) -> bool
+    {
+        if (n == graph_input || (walked & (1ul << n)))
+            return true;
+
+        if (walking & (1ul << n))
+            return false;
+
+        walking |= 1ul << n;
+        for (uint8_t i = 0; i < inputs_of(nodes[n]); i++)
+        {
+            if (!self(self, nodes[n].in[i]))
+                return false;
+        }
+
+        walked |= 1ul << n;
+        order[ordered++] = n;
+        return true;
+    };
+
+    if (!walk(walk, output))
+        return false;
+
+    /* Missing or bypassed effect is alias of its input (no step & no copy) */
+    std::array<uint8_t, max_nodes + 1> alias;
+    std::array<effect*, max_nodes> fx {};
+    alias[input_value] = input_value;
+
+    for (uint8_t k = 0; k < ordered; k++)
+    {
+        const uint8_t n = order[k];
+        alias[n] = n;
+
+        if (nodes[n].type == route_node::node_type::effect)
+        {
+            fx[n] = lookup(nodes[n].id);
+            if (fx[n] == nullptr)
+                alias[n] = alias[value_of(nodes[n].in[0])];
+        }
+    }
+
+    /* Number of pending reads of each value, output is read at the end */
+    const uint8_t output_value = alias[value_of(output)];
+    std::array<uint8_t, max_nodes + 1> reads {};
+    for (uint8_t k = 0; k < ordered; k++)
+    {
+        const uint8_t n = order[k];
+        if (alias[n] != n)
+            continue;
+
+        for (uint8_t i = 0; i < inputs_of(nodes[n]); i++)
+            reads[alias[value_of(nodes[n].in[i])]]++;
+    }
+    reads[output_value]++;
+
+    /* Buffer assignment, buffer is released after last read of its value */
+    std::array<uint8_t, max_nodes + 1> buffer_of {};
+    std::array<step, max_nodes> plan;
+    uint8_t planned = 0;
+    uint8_t used = 1;
+    uint32_t busy = 1;
+
+    auto release = [&](uint8_t v)
+    {
+        if (--reads[v] == 0)
+            busy &= ~(1ul << buffer_of[v]);
+    };
+
+    auto allocate = [&](uint8_t &buffer) -> bool
+    {
+        for (buffer = 0; buffer < max_buffers; buffer++)
+        {
+            if (!(busy & (1ul << buffer)))
+            {
+                busy |= 1ul << buffer;
+                used = std::max<uint8_t>(used, buffer + 1);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (uint8_t k = 0; k < ordered; k++)
+    {
+        const uint8_t n = order[k];
+        if (alias[n] != n)
+            continue;
+
+        const uint8_t v0 = alias[value_of(nodes[n].in[0])];
+        const uint8_t v1 = inputs_of(nodes[n]) > 1 ? alias[value_of(nodes[n].in[1])] : v0;
+        step &s = plan[planned++];
+        s.type = nodes[n].type;
+        s.fx = fx[n];
+        s.in = {buffer_of[v0], buffer_of[v0]};
+        s.mix = 0;
+
+        if (s.type == route_node::node_type::effect)
+        {
+            /* Effect can't process in place, so its input is released after output is allocated */
+            if (!allocate(s.out))
+                return false;
+
+            release(v0);
+        }
+        else
+        {
+            /* Mix is computed sample by sample, so output may take buffer of its input */
+            s.in[1] = buffer_of[v1];
+            s.mix = std::min<uint8_t>(nodes[n].mix_pct, 100) / 100.0f;
+            release(v0);
+            release(v1);
+
+            if (!allocate(s.out))
+                return false;
+        }
+
+        buffer_of[n] = s.out;
+    }
+
+    this->steps = plan;
+    this->step_count = planned;
+    this->out_buffer = buffer_of[output_value];
+    this->used_buffers = used;
+    return true;
+}
@@ -0,0 +1,80 @@
+/*
+ * effect_graph.hpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef MODEL_EFFECT_GRAPH_HPP_
+#define MODEL_EFFECT_GRAPH_HPP_
+
+#include "effect_interface.hpp"
+
+#include <array>
+#include <functional>
+
+namespace mfx
+{
+
+/*
+ * Processes mono or stereo signal by effect. Stereo effect gets mono input in both channels, mono effect in stereo
+ * signal processes only mid signal (once per block), side signal is passed around it through 'side' buffer.
+ */
+void run_effect(effect &e, const dsp_buffer &in_l, const dsp_buffer &in_r, bool input_stereo,
+                dsp_buffer &out_l, dsp_buffer &out_r, dsp_buffer &side);
+
+/*
+ * Node of effects graph: effect processing its input or mix of two inputs (output of node can feed many nodes).
+ * Chain holds one instance per effect ID, so effect node refers to its instance by ID (the same effect can't be
+ * used by two nodes).
+ */
+struct route_node
+{
+    enum class node_type : uint8_t { effect, mix } type;
+    effect_id id; // Effect node: processed effect (missing or bypassed effect passes its input through)
+    std::array<uint8_t, 2> in; // Indices of input nodes or effect_graph::graph_input (only mix node uses both)
+    uint8_t mix_pct; // Mix node: share of second input in output (0 - first input only, 100 - second input only)
+};
+
+/*
+ * Execution plan of effects graph. Nodes are sorted topologically, nodes not contributing to output are dropped
+ * and each node output gets one of physical buffers, which is reused as soon as its value is consumed by last
+ * reader (like registers in compiler). Buffer 0 holds graph input, linear chain uses only buffers 0 & 1.
+ */
+class effect_graph
+{
+public:
+    static constexpr uint8_t max_nodes {16};
+    static constexpr uint8_t max_buffers {4};
+    static constexpr uint8_t graph_input {0xFF};
+
+    struct step
+    {
+        route_node::node_type type;
+        effect *fx; // Effect node only
+        std::array<uint8_t, 2> in; // Buffer indices
+        uint8_t out;
+        float mix; // Mix node only
+    };
+
+    /* Effect for given ID, nullptr if it is missing or bypassed */
+    typedef std::function<effect*(effect_id id)> lookup_t;
+
+    /* Returns false (plan is not changed) if graph has cycle, invalid node index or needs more than max_buffers */
+    bool compile(const route_node *nodes, uint8_t count, uint8_t output, const lookup_t &lookup);
+
+    const step* begin(void) const { return this->steps.data(); };
+    const step* end(void) const { return this->steps.data() + this->step_count; };
+    uint8_t output_buffer(void) const { return this->out_buffer; };
+    uint8_t buffers_used(void) const { return this->used_buffers; };
+
+private:
+    std::array<step, max_nodes> steps {};
+    uint8_t step_count {0};
+    uint8_t out_buffer {0};
+    uint8_t used_buffers {1};
+};
+
+}
+
+#endif /* MODEL_EFFECT_GRAPH_HPP_ */
@@ -9,6 +9,9 @@
 #define MODEL_EFFECT_INTERFACE_HPP_
 
 #include <cstdint>
+#include <cassert>
+#include <array>
+#include <algorithm>
 #include <vector>
 #include <string_view>
 #include <functional>
@@ -19,15 +22,54 @@
 namespace mfx
 {
 
+/* Buffer of DSP samples allocated for the largest block, size() is the size of current block */
+class dsp_buffer
+{
+public:
+    using value_type = float;
+    using iterator = float*;
+    using const_iterator = const float*;
+
+    void resize(size_t size) { assert(size <= config::dsp_max_buffer_size); this->length = size; };
+    size_t size() const { return this->length; };
+    constexpr static size_t max_size() { return config::dsp_max_buffer_size; };
+
+    float* data() { return this->samples.data(); };
+    const float* data() const { return this->samples.data(); };
+    iterator begin() { return this->samples.data(); };
+    iterator end() { return this->samples.data() + this->length; };
+    const_iterator begin() const { return this->samples.data(); };
+    const_iterator end() const { return this->samples.data() + this->length; };
+    float& operator[](size_t i) { return this->samples[i]; };
+    const float& operator[](size_t i) const { return this->samples[i]; };
+
+private:
+    std::array<float, config::dsp_max_buffer_size> samples;
+    size_t length {config::dsp_buffer_size};
+};
+
+/* Processing quality, lower levels trade sound quality for CPU time */
+enum class effect_quality : uint8_t
+{
+    low,
+    medium,
+    high,
+    _count
+};
+
 class effect
 {
 public:
-    typedef std::array<float, config::dsp_buffer_size> dsp_input;
-    typedef std::array<float, config::dsp_buffer_size> dsp_output;
+    typedef dsp_buffer dsp_input;
+    typedef dsp_buffer dsp_output;
 
-    effect(const effect_id id) : basic {id, effect_name[static_cast<uint8_t>(id)], true, 0}, aux_in {nullptr} {};
+    effect(const effect_id id) : basic {id, effect_name[static_cast<uint8_t>(id)], true, 0}, aux_in {nullptr}, quality {effect_quality::high} {};
     virtual ~effect() {};
 
+    /*
+     * Input must not be written (buffer may be read by other nodes of graph afterwards) & it's never the same buffer
+     * as output. The same applies to aux input & both inputs of process_stereo().
+     */
     virtual void process(const dsp_input &in, dsp_output &out) = 0;
     virtual const effect_specific_attr get_specific_attributes(void) const = 0;
 
@@ -37,9 +79,32 @@ public:
     void set_aux_input(const dsp_input &aux_in) { this->aux_in = &aux_in; };
     void set_callback(std::function<void(effect*)> cb) { this->callback = cb; };
 
+    /* Stereo effect processes separate left & right buffers (mono input is fed to both), others only mono signal */
+    virtual bool is_stereo(void) const { return false; };
+    virtual void process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r)
+    {
+        this->process(in_l, out_l);
+        std::copy(out_l.begin(), out_l.end(), out_r.begin());
+    };
+
+    /* Block sizes processed without extra latency (others are buffered up to effect's fixed processing block) */
+    virtual bool supports_block_size(size_t size) const { return true; };
+
+    /* Number of samples, for which output may still be audible after input became silent */
+    virtual uint32_t tail_length(void) const { return 0; };
+
+    /* Bring internal state (e.g. filled history) to steady state before effect joins the chain (may take long) */
+    virtual void warm_up(void) {};
+
+    /* Quality levels, cost_estimate() is relative cost of processing at given level (0 - effect has single level) */
+    virtual void set_quality(effect_quality level) { this->quality = level; };
+    virtual uint32_t cost_estimate(effect_quality level) const { return 0; };
+    effect_quality get_quality(void) const { return this->quality; };
+
 protected:
     effect_attr basic;
     const dsp_input *aux_in;
+    effect_quality quality;
     std::function<void(effect*)> callback;
 };
 
@@ -20,18 +20,9 @@
 #include <middlewares/i2c_manager.hpp>
 
 #include <cmsis_device.h> // For managing D-Cache & I-Cache
+#include <cmsis/dsp/arm_math.h>
 
-#include "app/model/tuner/tuner.hpp"
-#include "app/model/tremolo/tremolo.hpp"
-#include "app/model/echo/echo.hpp"
-#include "app/model/chorus/chorus.hpp"
-#include "app/model/reverb/reverb.hpp"
-#include "app/model/overdrive/overdrive.hpp"
-#include "app/model/cabinet_sim/cabinet_sim.hpp"
-#include "app/model/vocoder/vocoder.hpp"
-#include "app/model/phaser/phaser.hpp"
-#include "app/model/amp_sim/amp_sim.hpp"
-#include "app/model/nam/nam.hpp"
+#include "app/model/effect_catalog.hpp"
 #include "app/utils.hpp"
 
 using namespace mfx;
@@ -48,6 +39,85 @@ namespace
         uint32_t total_cycles = end - start;
         return total_cycles / cycles_per_us;
     }
+
+    float cycles_to_us(uint32_t cycles)
+    {
+        constexpr float us_per_cycle = 1e6f / hal::system::system_clock;
+        return cycles * us_per_cycle;
+    }
+
+    /* CPU cycles available for processing of one audio block */
+    uint32_t block_deadline_cycles(uint32_t block_size)
+    {
+        return static_cast<uint64_t>(hal::system::system_clock) * block_size / config::sampling_frequency_hz;
+    }
+
+    events::dsp_time_stats snapshot_cycle_stats(const libs::cycle_stats &s)
+    {
+        return
+        {
+            cycles_to_us(s.min()), cycles_to_us(s.avg()), cycles_to_us(s.percentile(0.5f)),
+            cycles_to_us(s.percentile(0.99f)), cycles_to_us(s.percentile(0.999f)), cycles_to_us(s.max()),
+            s.misses()
+        };
+    }
+
+    /* Block is silent when all samples are below threshold */
+    bool is_silent(const float *in, uint32_t n)
+    {
+        float peak = 0;
+        for (uint32_t i = 0; i < n; i++)
+            peak = std::max(peak, std::abs(in[i]));
+
+        return peak < config::dsp_silence_threshold;
+    }
+
+    /* Controls of effect carried over into staged chain, which are applied on audio thread (model is never loaded there) */
+    constexpr controls_mask carried_controls
+    {
+        neural_amp_modeler_attr::controls::in_vol_field | neural_amp_modeler_attr::controls::out_vol_field
+    };
+
+#ifndef CFG_DISABLE_NEURAL_AMP_MODELER
+    /* Staged NAM keeps model of running instance (without its own controls it gets default one) */
+    bool keeps_model(const effect *nam, const effect_controls &ctrl)
+    {
+        const effect_controls current = get_effect_controls(nam);
+        const uint8_t model_idx = static_cast<effect_id>(ctrl.index()) == effect_id::neural_amp_modeler ?
+                                  std::get<neural_amp_modeler_attr::controls>(ctrl).model_idx :
+                                  neural_amp_modeler_attr::default_ctrl.model_idx;
+
+        return std::get<neural_amp_modeler_attr::controls>(current).model_idx == model_idx;
+    }
+#endif
+
+    /* Exponential moving average with 1/16 weight of new value */
+    void update_average(uint32_t &avg, uint32_t value)
+    {
+        avg += static_cast<int32_t>(value - avg) / 16;
+    }
+
+    /* Split interleaved stereo Q31 samples (24bit extended onto 32bit MSB) into normalized left & right buffers */
+    void deinterleave_q31_to_float(const int32_t *in, float *left, float *right, uint32_t n)
+    {
+        constexpr float scale = 1.0f / 2147483648.0f;
+
+        /* Loop unrolled by 4 */
+        for (uint32_t blk = n >> 2; blk > 0; blk--)
+        {
+            left[0] = in[0] * scale; right[0] = in[1] * scale;
+            left[1] = in[2] * scale; right[1] = in[3] * scale;
+            left[2] = in[4] * scale; right[2] = in[5] * scale;
+            left[3] = in[6] * scale; right[3] = in[7] * scale;
+            in += 8; left += 4; right += 4;
+        }
+
+        for (uint32_t blk = n & 3; blk > 0; blk--)
+        {
+            *left++ = *in++ * scale;
+            *right++ = *in++ * scale;
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -55,7 +125,23 @@ namespace
 
 void effect_processor::dispatch(const event &e)
 {
-    std::visit([this](auto &&e) { this->event_handler(e); }, e.data);
+    if (!events::is_chain_event(e.data))
+        std::visit([this](auto &&e) { this->event_handler(e); }, e.data);
+    else if (this->is_chain_busy())
+        this->postpone_event(e);
+    else
+        this->handle_chain_event(e.data);
+}
+
+void effect_processor::handle_chain_event(const events::incoming &e)
+{
+    const bool busy = this->is_chain_busy();
+    this->chain_events_handled++;
+
+    std::visit([this](auto &&e) { this->event_handler(e); }, e);
+
+    if (!busy && this->is_chain_busy())
+        this->chain_busy_since = this->chain_events_handled;
 }
 
 void effect_processor::event_handler(const events::initialize &e)
@@ -78,6 +164,7 @@ void effect_processor::event_handler(const events::configuration &e)
     this->audio.set_output_volume(e.output_vol);
     this->audio.route_onboard_mic_to_aux(e.mic_routed_to_aux);
     this->audio.mute(e.output_muted);
+    this->set_block_size(e.dsp_block_size);
 
     /* Configure USB */
     if (e.usb_audio_if_enabled)
@@ -142,28 +229,18 @@ void effect_processor::event_handler(const events::configuration &e)
 
 void effect_processor::event_handler(const events::start_audio &e)
 {
-    /* Start audio capture */
-    this->audio.capture(this->audio_input.buffer.data(), this->audio_input.buffer.size(),
-    [this](auto && ...params)
-    {
-        this->audio_capture_cb(params...);
-    },
-    true);
-
-    /* Start audio playback */
-    this->audio.play(this->audio_output.buffer.data(), this->audio_output.buffer.size(),
-    [this](auto && ...params)
-    {
-        this->audio_play_cb(params...);
-    },
-    true);
+    this->start_audio_stream();
 }
 
 void effect_processor::event_handler(const events::add_effect &e)
 {
     /* Don't allow duplicates */
     if (!this->find_effect(e.id))
-        this->effects.push_back(std::move(this->create_new(e.id)));
+    {
+        /* Effect is spliced into chain when factory hands it over, following events wait for it */
+        this->effects_in_creation++;
+        this->factory.send({effect_factory_events::create {e.id}});
+    }
 }
 
 void effect_processor::event_handler(const events::remove_effect &e)
@@ -171,7 +248,23 @@ void effect_processor::event_handler(const events::remove_effect &e)
     std::vector<std::unique_ptr<effect>>::iterator it;
 
     if (this->find_effect(e.id, it))
+    {
+        /* Freeing of effect buffers is done by factory too */
+        this->factory.send({effect_factory_events::destroy {it->release()}});
         this->effects.erase(it);
+        this->effect_table[static_cast<uint8_t>(e.id)] = nullptr;
+        this->clear_degraded(e.id);
+        this->graph_dirty = true;
+
+        /* Effect to be carried over into staged chain is gone, so factory prepares it (after this one is destroyed) */
+        if (this->carried_over && this->carried_over->id == e.id)
+        {
+            const auto &staged = *this->carried_over;
+            this->staged_in_creation++;
+            this->factory.send({effect_factory_events::prepare {staged.id, staged.bypassed, staged.ctrl, this->carried_over_slot}});
+            this->carried_over.reset();
+        }
+    }
 }
 
 void effect_processor::event_handler(const events::move_effect &e)
@@ -186,8 +279,9 @@ void effect_processor::event_handler(const events::move_effect &e)
         if (it == (this->effects.end() - 1) && e.step > 0)
             return;
 
-        /* Only moves by +1/-1 are supported */
+        /* Only moves by +1/-1 are supported (effect table doesn't depend on position in chain) */
         std::swap(*it, *std::next(it, std::clamp(e.step, -1L, 1L)));
+        this->graph_dirty = true;
     }
 }
 
@@ -196,7 +290,12 @@ void effect_processor::event_handler(const events::bypass_effect &e)
     auto effect = this->find_effect(e.id);
 
     if (effect)
+    {
+        /* User decision overrides automatic degradation */
         effect->bypass(e.bypassed);
+        this->clear_degraded(e.id);
+        this->effect_sleep[static_cast<uint8_t>(e.id)] = {};
+    }
 }
 
 void effect_processor::event_handler(const events::set_mute &e)
@@ -237,7 +336,7 @@ void effect_processor::event_handler(const events::route_mic_to_aux &e)
     this->audio.route_onboard_mic_to_aux(e.value);
 
     /* Re-start audio capture */
-    this->audio.capture(this->audio_input.buffer.data(), this->audio_input.buffer.size(),
+    this->audio.capture(this->audio_input.buffer.data(), 2 * this->block_size * this->audio_input.channels,
     [this](auto && ...params)
     {
         this->audio_capture_cb(params...);
@@ -256,77 +355,241 @@ void effect_processor::event_handler(const events::enable_usb_direct_mon &e)
     this->usb_direct_mon = e.value;
 }
 
+void effect_processor::event_handler(const events::set_overload_policy &e)
+{
+    this->overload_policy = e;
+    this->consecutive_overruns = 0;
+    this->clean_blocks = 0;
+}
+
+void effect_processor::event_handler(const events::set_quality_governor &e)
+{
+    this->quality_governor = e;
+    this->governor_blocks = 0;
+}
+
+void effect_processor::event_handler(const events::set_dsp_block_size &e)
+{
+    if (e.samples == this->block_size)
+        return;
+
+    /* Audio buffers are re-sized, so streams have to be re-started */
+    const bool restart = this->audio_started;
+    if (restart)
+        this->stop_audio_stream();
+
+    this->set_block_size(e.samples);
+
+    if (restart)
+        this->start_audio_stream();
+}
+
 void effect_processor::event_handler(const events::process_audio &e)
 {
     const uint32_t cycles_start = hal::system::clock::cycles();
 
+#ifdef CORE_CM7
+    /* If D-Cache is enabled, it must be cleaned/invalidated for buffers used by DMA.
+       Moreover, functions 'SCB_*_by_Addr()' require address alignment of 32 bytes. */
+    SCB_InvalidateDCache_by_Addr(&this->audio_input.buffer[this->audio_input.sample_index], this->block_size * this->audio_input.channels * sizeof(this->audio_input.buffer[0]));
+#endif /* CORE_CM7 */
+
+    /* Transform RAW samples (24bit extended onto 32bit MSB) to normalized DSP buffers (left - main, right - aux) */
+    deinterleave_q31_to_float(&this->audio_input.buffer[this->audio_input.sample_index],
+                              this->dsp_main_input.data(), this->dsp_aux_input.data(), this->dsp_main_input.size());
+
+    /* Apply pending parameter changes */
+    this->process_controls();
+
     /* Handle USB audio */
     const bool usb_enabled = this->usb_audio.is_enabled();
     const bool unmute_sample = !usb_enabled || this->usb_direct_mon;
     if (usb_enabled)
         this->usb_audio.process();
 
-    /* Process effects */
-    std::reference_wrapper<decltype(this->dsp_output)> current_output = this->dsp_output;
-    std::reference_wrapper<decltype(this->dsp_main_input)> current_input = this->dsp_main_input;
-    for (auto &&effect : this->effects)
-    {
-        if (!effect->is_bypassed())
-        {
-            effect->set_aux_input(this->dsp_aux_input);
-            effect->process(current_input, current_output);
+    /* Old chain is fed with copy of input, because input buffer is reused by current chain */
+    if (this->crossfade_blocks_left > 0 && !this->fade_from_silence)
+        arm_copy_f32(this->dsp_main_input.data(), this->dsp_fade_buffers[0].data(), this->dsp_main_input.size());
 
-            /* Swap current buffers so that old output is new input */
-            std::swap(current_input, current_output);
-        }
-    }
+    /* Process effects graph (without effects pipelined to CM4) */
+    this->update_pipeline();
+    this->update_graph();
 
-    /* Set correct output buffer after all processing */
-    current_output = current_input;
+    const graph_buffers buffers
+    {
+        &this->dsp_main_input, &this->dsp_output, &this->dsp_branch_buffers[0], &this->dsp_branch_buffers[1]
+    };
+    auto &r = this->dsp_right_buffers;
+    const graph_buffers right {&r[0], &r[1], &r[2], &r[3]};
+    std::array<bool, effect_graph::max_buffers> stereo {};
+    uint8_t result = this->run_graph(this->graph, buffers, right, stereo, true);
+    bool stereo_result = stereo[result];
+
+    if (this->crossfade_blocks_left > 0)
+        this->crossfade(*buffers[result], *right[result], stereo_result);
+
+    /* NAM model is being switched, chain is faded out & muted until new chain is swapped in */
+    if (this->model_switch || this->chain_muted)
+        this->mute_chain(*buffers[result], *right[result], stereo_result);
+
+#ifdef DUAL_CORE_APP
+    /* Result of CM7 part is handed to CM4 & replaced by output of CM4 part for previous block */
+    result = this->process_pipeline(buffers, right, result, stereo_result);
+#endif /* DUAL_CORE_APP */
+    const auto &dsp_result = *buffers[result];
+
+    /* Transform normalized DSP samples to saturated Q31, left channel directly into USB audio buffer */
+    auto &to_host = this->usb_audio.audio_to_host.buffer;
+    const auto &from_host = this->usb_audio.audio_from_host.buffer;
+    const auto buffer_size = dsp_result.size();
+    arm_float_to_q31(dsp_result.data(), to_host.data(), buffer_size);
+
+    /* Mono result is duplicated to right channel */
+    const int32_t *right_q31 = to_host.data();
+    if (stereo_result)
+    {
+        arm_float_to_q31(right[result]->data(), this->dsp_right_q31.data(), buffer_size);
+        right_q31 = this->dsp_right_q31.data();
+    }
 
-    const auto out_buf_idx = this->audio_output.sample_index;
-    const auto buffer_size = current_output.get().size();
+    const uint32_t write_period = this->play_periods.load(std::memory_order_acquire);
+    auto *out = &this->audio_output.buffer[this->audio_output.sample_index];
+    constexpr int32_t sample_mask = ~((1 << (32 - this->audio_output.bps)) - 1);
+    const int32_t unmute_mask = unmute_sample ? -1 : 0;
     for (unsigned i = 0; i < buffer_size; ++i)
     {
-        /* Transform normalized DSP samples to RAW buffer (24bit onto 32bit MSB) */
-        decltype(this->audio_output.buffer)::value_type sample;
-
-        constexpr decltype(sample) min = -(1 << (this->audio_input.bps - 1));
-        constexpr decltype(sample) max = -min - 1;
-        constexpr decltype(sample) scale = -min;
-
-        sample = current_output.get()[i] * scale;
-        sample = std::clamp(sample, min, max) << 8;
-
-        /* Duplicate left channel to right channel & mix with received USB audio */
-        const auto left_idx = 2 * i;
-        const auto right_idx = left_idx + 1;
-        const auto out_sample = sample * unmute_sample;
-        this->audio_output.buffer[out_buf_idx + left_idx] = out_sample + this->usb_audio.audio_from_host.buffer[left_idx];
-        this->audio_output.buffer[out_buf_idx + right_idx] = out_sample + this->usb_audio.audio_from_host.buffer[right_idx];
-
-        /* Fill USB audio buffer */
-        this->usb_audio.audio_to_host.buffer[i] = sample;
+        /* Keep 24bit onto 32bit MSB (USB capture stays mono, it gets left channel) */
+        const int32_t sample_l = to_host[i] & sample_mask;
+        const int32_t sample_r = right_q31[i] & sample_mask;
+        to_host[i] = sample_l;
+
+        /* Mix with received USB audio */
+        out[2 * i] = (sample_l & unmute_mask) + from_host[2 * i];
+        out[2 * i + 1] = (sample_r & unmute_mask) + from_host[2 * i + 1];
     }
 
 #ifdef CORE_CM7
     /* If D-Cache is enabled, it must be cleaned/invalidated for buffers used by DMA.
        Moreover, functions 'SCB_*_by_Addr()' require address alignment of 32 bytes. */
-    SCB_CleanDCache_by_Addr(&this->audio_output.buffer[this->audio_output.sample_index], sizeof(this->audio_output.buffer) / 2);
+    SCB_CleanDCache_by_Addr(out, this->block_size * this->audio_output.channels * sizeof(this->audio_output.buffer[0]));
 #endif /* CORE_CM7 */
 
+    /* Xrun: DMA did not consume exactly one half since previous block, or switched halves while it was written */
+    const uint32_t end_period = this->play_periods.load(std::memory_order_acquire);
+    const bool xrun = this->xrun_check_armed && ((write_period - this->last_play_period) != 1 || end_period != write_period);
+    this->last_play_period = end_period;
+    this->xrun_check_armed = true;
+    if (xrun)
+        this->xruns++;
+
     const uint32_t cycles_end = hal::system::clock::cycles();
     this->processing_time_us = cpu_cycles_to_us(cycles_start, cycles_end);
+
+    /* Update profile, on deadline miss blame every effect active in this block */
+    const uint32_t block_cycles = cycles_end - cycles_start;
+    this->chain_profile.add(block_cycles);
+
+    const uint32_t deadline_cycles = block_deadline_cycles(this->block_size);
+    const bool overrun = xrun || block_cycles > deadline_cycles;
+    if (overrun)
+    {
+        this->chain_profile.add_deadline_miss();
+        for (auto &&effect : this->effects)
+        {
+            if (!effect->is_bypassed())
+                this->effect_profile[static_cast<uint8_t>(effect->get_basic_attributes().id)].add_deadline_miss();
+        }
+    }
+
+    this->handle_overload(overrun, block_cycles);
+    this->govern_quality();
 }
 
 void effect_processor::event_handler(const events::get_dsp_load &e)
 {
-    this->notify(events::dsp_load_changed {this->get_processing_load()});
+#ifdef DUAL_CORE_APP
+    const uint8_t cm4_load = this->pipeline_path != pipeline_path::local ? this->pipeline.get_load(this->block_size) : 0;
+#else
+    const uint8_t cm4_load = 0;
+#endif /* DUAL_CORE_APP */
+
+    this->notify(events::dsp_load_changed {this->get_processing_load(), cm4_load});
+}
+
+void effect_processor::event_handler(const events::get_dsp_profile &e)
+{
+    /* Only snapshot of statistics is taken here, it's printed by receiver (blocking UART would stall audio) */
+    events::dsp_profile_summary summary {};
+    summary.blocks = this->chain_profile.samples();
+    summary.block_size = this->block_size;
+    summary.budget_us = cycles_to_us(block_deadline_cycles(this->block_size));
+    summary.total = snapshot_cycle_stats(this->chain_profile);
+    summary.xruns = this->xruns;
+
+#ifdef DUAL_CORE_APP
+    const size_t cm4_first = this->pipeline_path == pipeline_path::pipelined ? this->local_effects() : this->effects.size();
+    summary.cm4_active = cm4_first < this->effects.size();
+    if (summary.cm4_active)
+    {
+        summary.cm4_load_pct = this->pipeline.get_load(this->block_size);
+        summary.cm4_misses = this->pipeline.get_misses();
+    }
+#else
+    const size_t cm4_first = this->effects.size();
+#endif /* DUAL_CORE_APP */
+
+    this->notify(summary);
+
+    for (size_t i = 0; i < this->effects.size(); i++)
+    {
+        const auto &effect = this->effects[i];
+        const effect_id id = effect->get_basic_attributes().id;
+        const effect_quality q = effect->get_quality();
+
+        events::dsp_profile_effect row {id, std::nullopt, i >= cm4_first, {}};
+        if (effect->cost_estimate(q))
+            row.quality = q;
+
+        if (row.on_cm4)
+        {
+#ifdef DUAL_CORE_APP
+            row.time.avg = cycles_to_us(this->pipeline.get_effect_cycles(id));
+#endif /* DUAL_CORE_APP */
+        }
+        else
+        {
+            row.time = snapshot_cycle_stats(this->effect_profile[static_cast<uint8_t>(id)]);
+        }
+
+        this->notify(row);
+    }
+
+    if (e.reset)
+        this->reset_profile();
 }
 
 void effect_processor::event_handler(const events::set_effect_controls &e)
 {
-    std::visit([this](auto &&ctrl) { this->set_controls(ctrl); }, e.ctrl);
+    /* Controls are listed in the same order as effect IDs */
+    auto effect = this->find_effect(static_cast<effect_id>(e.ctrl.index()));
+
+    if (effect == nullptr)
+        return;
+
+    const bool changed = apply_effect_controls(effect, e.ctrl, e.changed);
+
+#ifdef DUAL_CORE_APP
+    /* Controls are mirrored to CM4 only if effect is in its stage, pending renewal of instance gets them too */
+    const auto id = static_cast<uint8_t>(e.ctrl.index());
+    if (this->pipeline.contains(static_cast<effect_id>(id)))
+        this->pipeline_dirty = true;
+    if (this->renew_pending & (1UL << id))
+        this->renew_changed[id] |= e.changed;
+#endif /* DUAL_CORE_APP */
+
+    /* Notify about change in internal structure of effect */
+    if (changed)
+        this->notify_effect_attributes_changed(effect);
 }
 
 void effect_processor::event_handler(const events::get_effect_attributes &e)
@@ -341,184 +604,799 @@ void effect_processor::event_handler(const effect_processor_events::enumerate_ef
     for (auto it = this->effects.begin(); it != this->effects.end(); ++it)
     {
         bool is_last = std::next(it) == this->effects.end();
-        this->notify(events::effect_attributes_enumerated {is_last, (*it)->get_basic_attributes(), (*it)->get_specific_attributes()});
+
+        /* Automatic degradation is not a part of preset */
+        effect_attr basic = (*it)->get_basic_attributes();
+        if (this->is_degraded(basic.id))
+            basic.bypassed = false;
+
+        this->notify(events::effect_attributes_enumerated {is_last, basic, (*it)->get_specific_attributes()});
     }
 }
 
-void effect_processor::set_controls(const tuner_attr::controls &ctrl)
+void effect_processor::event_handler(const events::stage_effect &e)
 {
-    auto tuner_effect = static_cast<tuner*>(this->find_effect(effect_id::tuner));
+    /* Each effect can be staged only once */
+    const uint32_t id_bit = 1UL << static_cast<uint8_t>(e.id);
+    if (this->staged_ids & id_bit || this->staged_effects.size() == this->staged_effects.capacity())
+        return;
+
+    const uint8_t slot = this->staged_effects.size();
+    this->staged_effects.emplace_back(nullptr);
+    this->staged_ids |= id_bit;
+
+#ifndef CFG_DISABLE_NEURAL_AMP_MODELER
+    const effect *nam = this->find_effect(e.id);
+    if (e.id == effect_id::neural_amp_modeler && nam != nullptr)
+    {
+        if (keeps_model(nam, e.ctrl))
+        {
+            this->carried_over = e;
+            this->carried_over_slot = slot;
+            return;
+        }
 
-    if (tuner_effect == nullptr)
+        /* Old model must not run while factory loads new one, it's removed after chain is faded out */
+        this->staged_in_creation++;
+        this->model_switch = e;
+        this->model_switch_slot = slot;
+        if (!this->audio_started)
+            this->switch_model();
         return;
+    }
+#endif
 
-    tuner_effect->set_mute_mode(ctrl.mute);
-    tuner_effect->set_a4_tuning(ctrl.a4_tuning);
+    this->staged_in_creation++;
+    this->factory.send({effect_factory_events::prepare {e.id, e.bypassed, e.ctrl, slot}});
 }
 
-void effect_processor::set_controls(const tremolo_attr::controls &ctrl)
+void effect_processor::event_handler(const events::commit_chain &e)
 {
-    auto tremolo_effect = static_cast<tremolo*>(this->find_effect(effect_id::tremolo));
+    this->crossfade_blocks = e.crossfade_blocks;
 
-    if (tremolo_effect == nullptr)
-        return;
+    /* Following events refer to new chain, so they wait until it's complete */
+    if (this->staged_in_creation > 0)
+        this->chain_commit_pending = true;
+    else
+        this->swap_chain();
+}
+
+void effect_processor::event_handler(const events::set_routing &e)
+{
+    const uint8_t nodes = this->routing_nodes;
+    const uint8_t output = this->routing_output;
+    const auto routing = this->routing;
 
-    tremolo_effect->set_rate(ctrl.rate);
-    tremolo_effect->set_depth(ctrl.depth);
-    tremolo_effect->set_shape(ctrl.shape);
+    this->routing = e.nodes;
+    this->routing_nodes = e.count;
+    this->routing_output = e.output;
+
+    /* Check if graph is valid & fits into buffers (for current set of active effects) */
+    effect_graph g;
+    if (this->compile_graph(g, this->effects, this->local_effects(), this->routing_nodes > 0))
+    {
+        this->graph_dirty = true;
+        this->notify(events::routing_changed {true, e.count, g.buffers_used()});
+    }
+    else
+    {
+        this->routing = routing;
+        this->routing_nodes = nodes;
+        this->routing_output = output;
+        this->notify(events::routing_changed {false, nodes, 0});
+    }
 }
 
-void effect_processor::set_controls(const echo_attr::controls &ctrl)
+void effect_processor::event_handler(const events::set_dsp_pipeline &e)
 {
-    auto echo_effect = static_cast<echo*>(this->find_effect(effect_id::echo));
+#ifdef DUAL_CORE_APP
+    /* Delay of CM7-only output starts from silence (latency changes only when pipeline is turned on/off) */
+    if ((e.mode == events::pipeline_mode::off) != (this->pipeline_config.mode == events::pipeline_mode::off))
+        this->pipeline.reset_delay();
+
+    this->pipeline_config = e;
+    this->pipeline_blocks = 0;
+    this->notify(events::dsp_pipeline_changed {e.mode, true});
+#else
+    this->notify(events::dsp_pipeline_changed {e.mode, false});
+#endif /* DUAL_CORE_APP */
+}
 
-    if (echo_effect == nullptr)
-        return;
+void effect_processor::event_handler(const events::effect_created &e)
+{
+    this->take_created_effects();
+    this->replay_postponed_events();
+}
 
-    echo_effect->set_mode(ctrl.mode);
-    echo_effect->set_blur(ctrl.blur);
-    echo_effect->set_time(ctrl.time);
-    echo_effect->set_feedback(ctrl.feedback);
+void effect_processor::notify_effect_attributes_changed(const effect *e)
+{
+    this->notify(events::effect_attributes_changed {e->get_basic_attributes(), e->get_specific_attributes()});
 }
 
-void effect_processor::set_controls(const chorus_attr::controls &ctrl)
+bool effect_processor::take_created_effects(void)
 {
-    auto chorus_effect = static_cast<chorus*>(this->find_effect(effect_id::chorus));
+    bool taken = false;
+    effect_factory_events::created c;
 
-    if (chorus_effect == nullptr)
-        return;
+    while (this->created_effects.pop(c))
+    {
+        taken = true;
+
+        if (c.purpose == effect_factory_events::created::purpose::stage)
+        {
+            c.instance->set_callback([this](effect* e) { this->notify_effect_attributes_changed(e); });
+            this->staged_effects[c.slot].reset(c.instance);
+            this->staged_in_creation--;
+        }
+        else if (c.purpose == effect_factory_events::created::purpose::renew)
+        {
+            this->renew_effect(c.instance);
+        }
+        else
+        {
+            this->splice_effect(c.instance);
+        }
+    }
+
+    if (this->chain_commit_pending && this->staged_in_creation == 0)
+    {
+        this->chain_commit_pending = false;
+        this->swap_chain();
+    }
 
-    chorus_effect->set_depth(ctrl.depth);
-    chorus_effect->set_rate(ctrl.rate);
-    chorus_effect->set_tone(ctrl.tone);
-    chorus_effect->set_mix(ctrl.mix);
-    chorus_effect->set_mode(ctrl.mode);
+    return taken;
 }
 
-void effect_processor::set_controls(const reverb_attr::controls &ctrl)
+void effect_processor::splice_effect(effect *instance)
 {
-    auto reverb_effect = static_cast<reverb*>(this->find_effect(effect_id::reverb));
+    const auto id = static_cast<uint8_t>(instance->get_basic_attributes().id);
 
-    if (reverb_effect == nullptr)
-        return;
+    instance->set_callback([this](effect* e) { this->notify_effect_attributes_changed(e); });
+    this->effects.emplace_back(instance);
+    this->effect_table[id] = instance;
+    this->graph_dirty = true;
+    this->effect_profile[id].reset();
+    this->effect_cycles_avg[id] = 0;
+    this->effect_sleep[id] = {};
 
-    reverb_effect->set_bandwidth(ctrl.bandwidth);
-    reverb_effect->set_damping(ctrl.damping);
-    reverb_effect->set_decay(ctrl.decay);
-    reverb_effect->set_mode(ctrl.mode);
+    this->effects_in_creation--;
 }
 
-void effect_processor::set_controls(const overdrive_attr::controls &ctrl)
+void effect_processor::renew_effect(effect *instance)
 {
-    auto overdrive_effect = static_cast<overdrive*>(this->find_effect(effect_id::overdrive));
+    const effect_id id = instance->get_basic_attributes().id;
+    std::vector<std::unique_ptr<effect>>::iterator it;
+
+#ifdef DUAL_CORE_APP
+    const auto id_bit = 1UL << static_cast<uint8_t>(id);
+    const bool requested = this->renew_pending & id_bit;
+    this->renew_pending &= ~id_bit;
 
-    if (overdrive_effect == nullptr)
+    /* Stale instance is replaced only while it's not processed (effect is still pipelined) */
+    if (requested && this->pipeline_path == pipeline_path::pipelined && this->pipeline.contains(id) && this->find_effect(id, it))
+    {
+        /* Controls changed after request are applied like on the old instance */
+        effect *old = it->get();
+        instance->set_callback([this](effect* e) { this->notify_effect_attributes_changed(e); });
+        instance->bypass(old->is_bypassed());
+        if (instance->get_quality() != old->get_quality())
+            instance->set_quality(old->get_quality());
+        apply_effect_controls(instance, get_effect_controls(old), this->renew_changed[static_cast<uint8_t>(id)]);
+
+        this->factory.send({effect_factory_events::destroy {it->release()}});
+        it->reset(instance);
+        this->effect_table[static_cast<uint8_t>(id)] = instance;
+        this->effect_sleep[static_cast<uint8_t>(id)] = {};
         return;
+    }
+#endif /* DUAL_CORE_APP */
 
-    overdrive_effect->set_mode(ctrl.mode);
-    overdrive_effect->set_high(ctrl.high);
-    overdrive_effect->set_low(ctrl.low);
-    overdrive_effect->set_gain(ctrl.gain);
-    overdrive_effect->set_mix(ctrl.mix);
+    this->factory.send({effect_factory_events::destroy {instance}});
 }
 
-void effect_processor::set_controls(const cabinet_sim_attr::controls &ctrl)
+void effect_processor::swap_chain(void)
 {
-    auto cab_sim_effect = static_cast<cabinet_sim*>(this->find_effect(effect_id::cabinet_sim));
+    /* Carried over effect is always in current chain (if it's removed, factory prepares it), only pointer is moved */
+    const bool carried = this->carried_over.has_value();
+    std::vector<std::unique_ptr<effect>>::iterator it;
+    if (carried && this->find_effect(this->carried_over->id, it))
+    {
+        const auto &staged = *this->carried_over;
 
-    if (cab_sim_effect == nullptr)
-        return;
+        /* Model is the same, so only bypass & volumes are changed (no model loading) */
+        (*it)->bypass(staged.bypassed);
+        if (static_cast<effect_id>(staged.ctrl.index()) == staged.id)
+            apply_effect_controls(it->get(), staged.ctrl, carried_controls);
+
+        this->staged_effects[this->carried_over_slot] = std::move(*it);
+        this->effects.erase(it);
+    }
+    this->carried_over.reset();
+    this->staged_ids = 0;
+
+    /* Chain which is still being faded out (after previous swap) is dropped */
+    this->release_chain(this->fading_effects);
+
+    /* Rotate chains without reallocation: staged -> current -> fading */
+    std::swap(this->fading_effects, this->effects);
+    std::swap(this->effects, this->staged_effects);
+    this->index_effects();
+
+    for (auto &&effect : this->effects)
+    {
+        const auto id = static_cast<uint8_t>(effect->get_basic_attributes().id);
+        this->effect_profile[id].reset();
+        this->effect_cycles_avg[id] = 0;
+        this->effect_sleep[id] = {};
+    }
 
-    cab_sim_effect->set_ir(ctrl.ir_idx);
+    this->graph_dirty = true;
+
+#ifdef DUAL_CORE_APP
+    /* CM4 stage holds effects of old chain, new one is processed by CM7 until stage is reconfigured */
+    this->pipeline_path = pipeline_path::local;
+    this->pipeline_fade = 0;
+#endif /* DUAL_CORE_APP */
+
+    /* Degradation was applied to old chain */
+    this->degraded_count = 0;
+    this->consecutive_overruns = 0;
+    this->clean_blocks = 0;
+
+    /*
+     * Old chain which lost carried over effect would sound differently, so it's dropped at once. Muted old chain
+     * (after model switch) is dropped too & new one is faded in from silence.
+     */
+    this->fade_from_silence = this->chain_muted;
+    this->chain_muted = false;
+    this->crossfade_blocks_left = carried ? 0 : this->crossfade_blocks;
+    if (this->crossfade_blocks_left == 0 || this->fade_from_silence)
+        this->release_chain(this->fading_effects);
+
+    /* Old chain is processed by its own plan: with the same routing (if possible) & whole on this core */
+    if (this->crossfade_blocks_left > 0 && !this->fade_from_silence &&
+        !this->compile_graph(this->fading_graph, this->fading_effects, this->fading_effects.size(), this->routing_nodes > 0))
+        this->compile_graph(this->fading_graph, this->fading_effects, this->fading_effects.size(), false);
 }
 
-void effect_processor::set_controls(const vocoder_attr::controls &ctrl)
+void effect_processor::release_chain(std::vector<std::unique_ptr<effect>> &chain)
 {
-    auto vocoder_effect = static_cast<vocoder*>(this->find_effect(effect_id::vocoder));
+    for (auto &&effect : chain)
+        this->factory.send({effect_factory_events::destroy {effect.release()}});
 
-    if (vocoder_effect == nullptr)
-        return;
+    chain.clear();
+}
 
-    const auto current_mode = std::get<vocoder_attr>(vocoder_effect->get_specific_attributes()).ctrl.mode;
+void effect_processor::crossfade(effect::dsp_output &out_l, effect::dsp_output &out_r, bool &stereo)
+{
+    const uint32_t n = out_l.size();
 
-    vocoder_effect->set_mode(ctrl.mode);
-    vocoder_effect->hold(ctrl.hold);
-    vocoder_effect->set_tone(ctrl.tone);
-    vocoder_effect->set_clarity(ctrl.clarity);
-    vocoder_effect->set_bands(ctrl.bands);
+    /* Old chain is processed like current one (by its own plan & buffers), but without profiling & sleeping */
+    const dsp_buffer *old_l = nullptr;
+    const dsp_buffer *old_r = nullptr;
+    if (!this->fade_from_silence)
+    {
+        auto &l = this->dsp_fade_buffers;
+        auto &r = this->dsp_fade_right_buffers;
+        std::array<bool, effect_graph::max_buffers> old_stereo {};
+        const uint8_t result = this->run_graph(this->fading_graph, {&l[0], &l[1], &l[2], &l[3]},
+                                               {&r[0], &r[1], &r[2], &r[3]}, old_stereo, false);
+        old_l = &l[result];
+        old_r = old_stereo[result] ? &r[result] : old_l;
+
+        /* Result is stereo if any of chains is, mono one has the same signal in both channels */
+        if (old_stereo[result] && !stereo)
+        {
+            arm_copy_f32(out_l.data(), out_r.data(), n);
+            stereo = true;
+        }
+    }
 
-    /* Notify about change in internal structure of effect */
-    if (current_mode != ctrl.mode)
-        this->notify_effect_attributes_changed(vocoder_effect);
+    /* Linear ramp across all crossfade blocks (both chains are fed with the same signal) */
+    const float step = 1.0f / (this->crossfade_blocks * n);
+    const float start = (this->crossfade_blocks - this->crossfade_blocks_left) * n * step;
+    auto ramp = [n, step, start](effect::dsp_output &out, const dsp_buffer *old)
+    {
+        float gain = start;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const float old_sample = old ? (*old)[i] : 0.0f;
+            out[i] = old_sample + gain * (out[i] - old_sample);
+            gain += step;
+        }
+    };
+
+    ramp(out_l, old_l);
+    if (stereo)
+        ramp(out_r, old_r);
+
+    if (--this->crossfade_blocks_left == 0)
+        this->release_chain(this->fading_effects);
 }
 
-void effect_processor::set_controls(const phaser_attr::controls &ctrl)
+void effect_processor::mute_chain(effect::dsp_output &out_l, effect::dsp_output &out_r, bool stereo)
 {
-    auto phaser_effect = static_cast<phaser*>(this->find_effect(effect_id::phaser));
+    const uint32_t n = out_l.size();
 
-    if (phaser_effect == nullptr)
+    if (this->chain_muted)
+    {
+        arm_fill_f32(0, out_l.data(), n);
+        if (stereo)
+            arm_fill_f32(0, out_r.data(), n);
         return;
+    }
+
+    /* Last block with old model is faded out, then old instance is destroyed & new one prepared by factory */
+    const float step = 1.0f / n;
+    float gain = 1.0f;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out_l[i] *= gain;
+        if (stereo)
+            out_r[i] *= gain;
+        gain -= step;
+    }
 
-    phaser_effect->set_rate(ctrl.rate);
-    phaser_effect->set_depth(ctrl.depth);
-    phaser_effect->set_contour(ctrl.contour);
+    this->switch_model();
 }
 
-void effect_processor::set_controls(const amp_sim_attr::controls &ctrl)
+void effect_processor::switch_model(void)
 {
-    auto amp_sim_effect = static_cast<amp_sim*>(this->find_effect(effect_id::amplifier_sim));
+    const auto &staged = *this->model_switch;
+    this->event_handler(events::remove_effect {staged.id});
+    this->factory.send({effect_factory_events::prepare {staged.id, staged.bypassed, staged.ctrl, this->model_switch_slot}});
+    this->model_switch.reset();
+    this->chain_muted = true;
+}
 
-    if (amp_sim_effect == nullptr)
-        return;
+bool effect_processor::compile_graph(effect_graph &g, const std::vector<std::unique_ptr<effect>> &chain,
+                                     uint8_t local, bool routed)
+{
+    /* Current chain is indexed by effect table, other chains (e.g. fading one) get temporary table */
+    std::array<effect*, static_cast<uint8_t>(effect_id::_count)> chain_table;
+    const auto *table = &this->effect_table;
+    if (&chain != &this->effects)
+    {
+        chain_table.fill(nullptr);
+        for (auto &&effect : chain)
+            chain_table[static_cast<uint8_t>(effect->get_basic_attributes().id)] = effect.get();
+        table = &chain_table;
+    }
+
+    auto lookup = [table](effect_id id) -> effect*
+    {
+        effect *e = (*table)[static_cast<uint8_t>(id)];
+        return (e != nullptr && !e->is_bypassed()) ? e : nullptr;
+    };
+
+    if (routed)
+        return g.compile(this->routing.data(), this->routing_nodes, this->routing_output, lookup);
 
-    amp_sim_effect->set_mode(ctrl.mode);
-    amp_sim_effect->set_input(ctrl.input);
-    amp_sim_effect->set_drive(ctrl.drive);
-    amp_sim_effect->set_compression(ctrl.compression);
-    amp_sim_effect->set_tone_stack(ctrl.bass, ctrl.mids, ctrl.treb);
+    /* Linear chain in order of effects (last ones may be processed by CM4) */
+    std::array<route_node, effect_graph::max_nodes> nodes;
+    uint8_t count = 0;
+    for (auto it = chain.begin(); it != chain.begin() + local; ++it)
+    {
+        const uint8_t prev = count > 0 ? count - 1 : effect_graph::graph_input;
+        nodes[count++] = {route_node::node_type::effect, (*it)->get_basic_attributes().id, {prev, prev}, 0};
+    }
+
+    return g.compile(nodes.data(), count, count > 0 ? count - 1 : effect_graph::graph_input, lookup);
 }
 
-void effect_processor::set_controls(const neural_amp_modeler_attr::controls &ctrl)
+uint8_t effect_processor::run_graph(const effect_graph &g, const graph_buffers &left, const graph_buffers &right,
+                                    std::array<bool, effect_graph::max_buffers> &stereo, bool profiled)
 {
-#ifndef CFG_DISABLE_NEURAL_AMP_MODELER
-    auto nam_effect = static_cast<neural_amp_modeler*>(this->find_effect(effect_id::neural_amp_modeler));
+    std::array<bool, effect_graph::max_buffers> silent {};
+    silent[0] = profiled && is_silent(left[0]->data(), left[0]->size());
+
+    for (auto &&step : g)
+    {
+        const uint8_t a = step.in[0];
+        const uint8_t o = step.out;
+
+        if (step.type == route_node::node_type::effect)
+        {
+            /* Mono signal is promoted to stereo by first stereo effect */
+            if (profiled)
+            {
+                silent[o] = this->process_effect(*step.fx, *left[a], *right[a], stereo[a], *left[o], *right[o], silent[a]);
+            }
+            else
+            {
+                step.fx->set_aux_input(this->dsp_aux_input);
+                run_effect(*step.fx, *left[a], *right[a], stereo[a], *left[o], *right[o], this->dsp_side);
+            }
+
+            stereo[o] = stereo[a] || step.fx->is_stereo();
+        }
+        else
+        {
+            /* Mix may be computed in place (output buffer can be one of inputs), so right channel goes first */
+            const uint8_t b = step.in[1];
+            const auto &al = *left[a];
+            const auto &bl = *left[b];
+            const auto &ar = stereo[a] ? *right[a] : al;
+            const auto &br = stereo[b] ? *right[b] : bl;
+            auto &out = *left[o];
+            auto &out_r = *right[o];
+
+            if (stereo[a] || stereo[b])
+            {
+                for (uint32_t i = 0; i < out.size(); i++)
+                    out_r[i] = ar[i] + step.mix * (br[i] - ar[i]);
+            }
+
+            for (uint32_t i = 0; i < out.size(); i++)
+                out[i] = al[i] + step.mix * (bl[i] - al[i]);
+
+            silent[o] = silent[a] && silent[b];
+            stereo[o] = stereo[a] || stereo[b];
+        }
+    }
 
-    if (nam_effect == nullptr)
+    return g.output_buffer();
+}
+
+void effect_processor::update_graph(void)
+{
+    /* Bypass changes are detected here, because they are done in many places (user, degradation) */
+    uint32_t active = 0;
+    for (auto &&effect : this->effects)
+    {
+        if (!effect->is_bypassed())
+            active |= 1ul << static_cast<uint8_t>(effect->get_basic_attributes().id);
+    }
+
+    const uint8_t local = this->local_effects();
+    if (!this->graph_dirty && active == this->graph_active_effects && local == this->graph_local_effects)
         return;
 
-    nam_effect->set_model(ctrl.model_idx);
-    nam_effect->set_input_volume(ctrl.in_vol);
-    nam_effect->set_output_volume(ctrl.out_vol);
-#endif
+    this->graph_dirty = false;
+    this->graph_active_effects = active;
+    this->graph_local_effects = local;
+
+#ifdef DUAL_CORE_APP
+    /* Bypass state of pipelined effects is mirrored to CM4 */
+    if (!this->pipeline.is_empty())
+        this->pipeline_dirty = true;
+#endif /* DUAL_CORE_APP */
+
+    /*
+     * Bypassing may make routing wider than available buffers, then only this plan falls back to linear chain.
+     * Routing is kept, so it's used again when effects are enabled back.
+     */
+    if (!this->compile_graph(this->graph, this->effects, local, this->routing_nodes > 0))
+        this->compile_graph(this->graph, this->effects, local, false);
 }
 
-void effect_processor::notify_effect_attributes_changed(const effect *e)
+uint8_t effect_processor::local_effects(void) const
 {
-    this->notify(events::effect_attributes_changed {e->get_basic_attributes(), e->get_specific_attributes()});
+#ifdef DUAL_CORE_APP
+    /* Effects after split are processed out of graph, while CM4 stage is used (otherwise graph has whole chain) */
+    if (this->routing_nodes == 0 && this->pipeline_path != pipeline_path::local)
+        return std::min<size_t>(this->pipeline_split, this->effects.size());
+#endif /* DUAL_CORE_APP */
+
+    return this->effects.size();
 }
 
-std::unique_ptr<effect> effect_processor::create_new(effect_id id)
-{
-    constexpr std::array<std::unique_ptr<effect>(*)(), static_cast<uint8_t>(effect_id::_count)> effect_factory
-    {{
-        []() -> std::unique_ptr<effect> { return std::make_unique<tuner>();              },
-        []() -> std::unique_ptr<effect> { return std::make_unique<tremolo>();            },
-        []() -> std::unique_ptr<effect> { return std::make_unique<echo>();               },
-        []() -> std::unique_ptr<effect> { return std::make_unique<chorus>();             },
-        []() -> std::unique_ptr<effect> { return std::make_unique<reverb>();             },
-        []() -> std::unique_ptr<effect> { return std::make_unique<overdrive>();          },
-        []() -> std::unique_ptr<effect> { return std::make_unique<cabinet_sim>();        },
-        []() -> std::unique_ptr<effect> { return std::make_unique<vocoder>();            },
-        []() -> std::unique_ptr<effect> { return std::make_unique<phaser>();             },
-        []() -> std::unique_ptr<effect> { return std::make_unique<amp_sim>();            },
-#ifndef CFG_DISABLE_NEURAL_AMP_MODELER
-        []() -> std::unique_ptr<effect> { return std::make_unique<neural_amp_modeler>(); }
-#endif
-    }};
+void effect_processor::update_pipeline(void)
+{
+#ifdef DUAL_CORE_APP
+    const uint8_t count = this->effects.size();
+    uint8_t split = count;
 
-    std::unique_ptr<effect> e = effect_factory.at(static_cast<uint8_t>(id))();
-    e->set_callback([this](effect* e) { this->notify_effect_attributes_changed(e); });
-    return e;
+    /* Pipeline is used only for linear chain & not while chains are crossfaded */
+    if (this->pipeline_config.mode != events::pipeline_mode::off && this->routing_nodes == 0 && this->crossfade_blocks_left == 0)
+    {
+        /* Only suffix of chain with effects which can run on CM4 can be pipelined */
+        uint8_t first = count;
+        while (first > 0 && count - first < dsp_pipeline_shared::max_stage_effects &&
+               is_offloadable(this->effects[first - 1]->get_basic_attributes().id))
+            first--;
+
+        if (this->pipeline_config.mode == events::pipeline_mode::manual)
+        {
+            split = std::max<int>(first, count - this->pipeline_config.cm4_effects);
+        }
+        else
+        {
+            split = std::clamp(this->pipeline_target, first, count);
+
+            /* Decide every 250ms, so that averages settle after previous change */
+            const uint32_t period_blocks = config::sampling_frequency_hz / 4 / this->block_size;
+            if (++this->pipeline_blocks >= period_blocks)
+            {
+                this->pipeline_blocks = 0;
+
+                /* CM4 did not make it in time, move one effect back to CM7 */
+                if (this->pipeline.get_misses() != this->pipeline_misses)
+                    split = std::min<uint8_t>(split + 1, count);
+                else
+                    split = this->balance_pipeline(first);
+
+                this->pipeline_misses = this->pipeline.get_misses();
+            }
+        }
+    }
+
+    this->pipeline_target = split;
+
+    /* Routed graph has no split point, so CM7 takes over whole chain at once */
+    if (this->routing_nodes > 0)
+    {
+        this->pipeline_path = pipeline_path::local;
+        this->pipeline_fade = 0;
+    }
+
+    /* CM4 stage is reconfigured only while CM7 processes whole chain, so each change goes through crossfade */
+    const auto stage_first = this->effects.begin() + std::min(this->pipeline_split, count);
+    const bool same_stage = split == this->pipeline_split && this->pipeline.is_configured(stage_first, this->effects.end());
+
+    switch (this->pipeline_path)
+    {
+    case pipeline_path::local:
+        if (!same_stage)
+        {
+            this->pipeline_split = split;
+            this->pipeline_dirty = false;
+            this->pipeline.configure(this->effects.begin() + split, this->effects.end());
+        }
+
+        if (split < count && this->pipeline.is_ready())
+            this->pipeline_path = pipeline_path::entering;
+        break;
+
+    case pipeline_path::entering:
+    case pipeline_path::pipelined:
+        if (!same_stage || !this->pipeline.is_ready())
+            this->pipeline_path = pipeline_path::leaving;
+        break;
+
+    case pipeline_path::leaving:
+        if (same_stage && this->pipeline.is_ready())
+            this->pipeline_path = pipeline_path::entering;
+        break;
+    }
+
+    /* Controls & bypass state of effects in CM4 stage are mirrored (set of effects is the same) */
+    if (this->pipeline_dirty && same_stage)
+    {
+        this->pipeline_dirty = false;
+        this->pipeline.configure(stage_first, this->effects.end());
+    }
+#endif /* DUAL_CORE_APP */
+}
+
+uint8_t effect_processor::process_pipeline(const graph_buffers &left, const graph_buffers &right, uint8_t result, bool &stereo)
+{
+#ifdef DUAL_CORE_APP
+    if (this->pipeline_path == pipeline_path::pipelined)
+    {
+        /* CM4 missed its deadline: CM7 instances process the rest of chain on delayed input, instead of dropout */
+        if (!this->pipeline.exchange(*left[result], *right[result], stereo))
+            result = this->process_pipeline_tail(left, right, result, stereo);
+        return result;
+    }
+
+    if (this->pipeline_path == pipeline_path::local)
+    {
+        /* Latency is added only when pipeline is enabled */
+        this->pipeline.pause();
+        if (this->pipeline_config.mode != events::pipeline_mode::off)
+            this->pipeline.delay(*left[result], *right[result], stereo);
+        return result;
+    }
+
+    /* Crossfade: CM7 part goes to CM4 stage, while CM7 processes the rest of linear chain too (buffer 2 is free) */
+    const uint32_t n = left[result]->size();
+    auto &cm4_l = *left[2];
+    auto &cm4_r = *right[2];
+    bool cm4_stereo = stereo;
+    arm_copy_f32(left[result]->data(), cm4_l.data(), n);
+    if (stereo)
+        arm_copy_f32(right[result]->data(), cm4_r.data(), n);
+    const bool cm4_valid = this->pipeline.exchange(cm4_l, cm4_r, cm4_stereo);
+
+    result = this->process_pipeline_tail(left, right, result, stereo);
+    this->pipeline.delay(*left[result], *right[result], stereo);
+
+    /* Fade position moves towards CM4 output while entering & back while leaving (late CM4 block is skipped) */
+    constexpr uint8_t fade_blocks = config::dsp_pipeline_crossfade_blocks;
+    const bool entering = this->pipeline_path == pipeline_path::entering;
+    if (cm4_valid)
+    {
+        auto &out_l = *left[result];
+        auto &out_r = *right[result];
+        if (cm4_stereo && !stereo)
+        {
+            arm_copy_f32(out_l.data(), out_r.data(), n);
+            stereo = true;
+        }
+
+        const float step = (entering ? 1.0f : -1.0f) / (fade_blocks * n);
+        const float start = static_cast<float>(this->pipeline_fade) / fade_blocks;
+        auto ramp = [n, step, start](dsp_buffer &out, const dsp_buffer &cm4)
+        {
+            float gain = start;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                out[i] += gain * (cm4[i] - out[i]);
+                gain += step;
+            }
+        };
+
+        ramp(out_l, cm4_l);
+        if (stereo)
+            ramp(out_r, cm4_stereo ? cm4_r : cm4_l);
+    }
+
+    if (entering && cm4_valid && ++this->pipeline_fade == fade_blocks)
+    {
+        this->pipeline_path = pipeline_path::pipelined;
+
+        /* CM7 instances of pipelined effects are not processed from now on, so they are renewed (state would get stale) */
+        for (auto it = this->effects.begin() + this->local_effects(); it != this->effects.end(); ++it)
+        {
+            const effect *e = it->get();
+            const auto id = static_cast<uint8_t>(e->get_basic_attributes().id);
+            this->renew_pending |= 1UL << id;
+            this->renew_changed[id] = 0;
+            this->factory.send({effect_factory_events::renew {e->get_basic_attributes().id, e->is_bypassed(),
+                                                              get_effect_controls(e), e->get_quality()}});
+        }
+    }
+    else if (!entering && (this->pipeline_fade == 0 || --this->pipeline_fade == 0))
+    {
+        this->pipeline_path = pipeline_path::local;
+        this->pipeline_fade = 0;
+    }
+#endif /* DUAL_CORE_APP */
+
+    return result;
+}
+
+uint8_t effect_processor::process_pipeline_tail(const graph_buffers &left, const graph_buffers &right, uint8_t result, bool &stereo)
+{
+#ifdef DUAL_CORE_APP
+    /* CM7 instances of pipelined effects, linear chain uses only buffers 0 & 1 */
+    for (auto it = this->effects.begin() + this->local_effects(); it != this->effects.end(); ++it)
+    {
+        if ((*it)->is_bypassed())
+            continue;
+
+        const uint8_t o = result ^ 1;
+        this->process_effect(**it, *left[result], *right[result], stereo, *left[o], *right[o], false);
+        stereo = stereo || (*it)->is_stereo();
+        result = o;
+    }
+#endif /* DUAL_CORE_APP */
+
+    return result;
+}
+
+uint8_t effect_processor::balance_pipeline(uint8_t first_offloadable) const
+{
+#ifdef DUAL_CORE_APP
+    /* Time of each effect on both cores (in CM7 cycles), CM4 time is estimated until effect is measured there */
+    const uint8_t count = this->effects.size();
+    std::array<uint32_t, static_cast<uint8_t>(effect_id::_count)> cm7_cycles {}, cm4_cycles {};
+    uint32_t cm7_total = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const auto &effect = this->effects[i];
+        if (effect->is_bypassed())
+            continue;
+
+        const effect_id id = effect->get_basic_attributes().id;
+        cm7_cycles[i] = this->effect_cycles_avg[static_cast<uint8_t>(id)];
+        cm4_cycles[i] = this->pipeline.get_effect_cycles(id);
+        if (cm4_cycles[i] == 0)
+            cm4_cycles[i] = cm7_cycles[i] * config::dsp_pipeline_cm4_cost_ratio;
+
+        cm7_total += cm7_cycles[i];
+    }
+
+    /* Block time is given by slower core, walk splits from the end (CM7 part shrinks, CM4 part grows) */
+    auto block_cycles = [&](uint8_t split)
+    {
+        uint32_t cm7 = cm7_total, cm4 = 0;
+        for (uint8_t i = split; i < count; i++)
+        {
+            cm7 -= cm7_cycles[i];
+            cm4 += cm4_cycles[i];
+        }
+        return std::max(cm7, cm4);
+    };
+
+    uint8_t best = count;
+    uint32_t best_cycles = block_cycles(count);
+    for (uint8_t split = count; split-- > first_offloadable;)
+    {
+        const uint32_t cycles = block_cycles(split);
+        if (cycles < best_cycles)
+        {
+            best = split;
+            best_cycles = cycles;
+        }
+    }
+
+    /* Split is changed only if it saves at least 5% of block time (each change restarts CM4 stage) */
+    const uint8_t current = std::clamp(this->pipeline_target, first_offloadable, count);
+    const uint32_t hysteresis_cycles = block_deadline_cycles(this->block_size) / 20;
+    return block_cycles(current) > best_cycles + hysteresis_cycles ? best : current;
+#else
+    return this->effects.size();
+#endif /* DUAL_CORE_APP */
+}
+
+bool effect_processor::process_effect(effect &e, const effect::dsp_input &in_l, const effect::dsp_input &in_r, bool input_stereo,
+                                      effect::dsp_output &out_l, effect::dsp_output &out_r, bool input_silent)
+{
+    const auto id = static_cast<uint8_t>(e.get_basic_attributes().id);
+    auto &sleep = this->effect_sleep[id];
+    const bool output_stereo = input_stereo || e.is_stereo();
+
+    if (input_silent)
+        sleep.silent_samples = std::min<uint64_t>(static_cast<uint64_t>(sleep.silent_samples) + this->block_size, UINT32_MAX);
+    else
+        sleep.silent_samples = 0;
+
+    if (sleep.output_silent && sleep.silent_samples > e.tail_length())
+    {
+        /* Asleep: input & tail are silent, so emit zeros until signal returns */
+        arm_fill_f32(0, out_l.data(), out_l.size());
+        if (output_stereo)
+            arm_fill_f32(0, out_r.data(), out_r.size());
+    }
+    else
+    {
+        const uint32_t effect_start = hal::system::clock::cycles();
+
+        e.set_aux_input(this->dsp_aux_input);
+        run_effect(e, in_l, in_r, input_stereo, out_l, out_r, this->dsp_side);
+
+        const uint32_t effect_cycles = hal::system::clock::cycles() - effect_start;
+        this->effect_profile[id].add(effect_cycles);
+        update_average(this->effect_cycles_avg[id], effect_cycles);
+
+        sleep.output_silent = is_silent(out_l.data(), out_l.size()) &&
+                              (!output_stereo || is_silent(out_r.data(), out_r.size()));
+    }
+
+    return sleep.output_silent;
+}
+
+bool effect_processor::is_chain_busy(void) const
+{
+    return this->effects_in_creation > 0 || this->chain_commit_pending;
+}
+
+void effect_processor::postpone_event(const event &e)
+{
+    /* Postponed events come from controller (mutable), each of them owns one pool slot, so ring never overflows */
+    assert(!e.immutable && this->postponed_count < this->postponed_events.size());
+
+    const size_t tail = (this->postponed_head + this->postponed_count) % this->postponed_events.size();
+    this->postponed_events[tail] = &e;
+    this->postponed_count++;
+    this->hold(e);
+}
+
+void effect_processor::replay_postponed_events(void)
+{
+    /* Stop when replayed event starts creation of another effect or waits for staged chain */
+    while (!this->is_chain_busy() && this->postponed_count > 0)
+    {
+        /* Event is taken out before it's handled, handler may replay rest of events */
+        const event *e = this->postponed_events[this->postponed_head];
+        this->postponed_head = (this->postponed_head + 1) % this->postponed_events.size();
+        this->postponed_count--;
+
+        this->handle_chain_event(e->data);
+        this->release(e);
+    }
 }
 
 bool effect_processor::find_effect(effect_id id, std::vector<std::unique_ptr<effect>>::iterator &it)
@@ -531,32 +1409,89 @@ bool effect_processor::find_effect(effect_id id, std::vector<std::unique_ptr<eff
     return effect_it != std::end(this->effects);
 }
 
-effect* effect_processor::find_effect(effect_id id)
+effect* effect_processor::find_effect(effect_id id) const
 {
-    std::vector<std::unique_ptr<effect>>::iterator it;
-    return this->find_effect(id, it) ? (*it).get() : nullptr;
+    return this->effect_table[static_cast<uint8_t>(id)];
 }
 
-void effect_processor::audio_capture_cb(const hal::audio_devices::codec::input_sample_t *input, uint16_t length)
+void effect_processor::index_effects(void)
 {
-    /* WARNING: This method could have been called from interrupt */
+    this->effect_table.fill(nullptr);
+    for (auto &&effect : this->effects)
+        this->effect_table[static_cast<uint8_t>(effect->get_basic_attributes().id)] = effect.get();
+}
 
-#ifdef CORE_CM7
-    /* If D-Cache is enabled, it must be cleaned/invalidated for buffers used by DMA.
-       Moreover, functions 'SCB_*_by_Addr()' require address alignment of 32 bytes. */
-    SCB_InvalidateDCache_by_Addr(const_cast<hal::audio_devices::codec::input_sample_t*>(input), length * sizeof(*input));
-#endif /* CORE_CM7 */
+void effect_processor::set_block_size(uint16_t samples)
+{
+    /* Only powers of 2 in supported range */
+    if (samples < config::dsp_min_buffer_size || samples > config::dsp_max_buffer_size || (samples & (samples - 1)))
+        samples = config::dsp_buffer_size;
+
+    this->block_size = samples;
+    this->dsp_main_input.resize(samples);
+    this->dsp_aux_input.resize(samples);
+    this->dsp_output.resize(samples);
+    for (auto &&buffer : this->dsp_fade_buffers)
+        buffer.resize(samples);
+    for (auto &&buffer : this->dsp_fade_right_buffers)
+        buffer.resize(samples);
+    for (auto &&buffer : this->dsp_branch_buffers)
+        buffer.resize(samples);
+    for (auto &&buffer : this->dsp_right_buffers)
+        buffer.resize(samples);
+    this->dsp_side.resize(samples);
+    this->usb_audio.set_block_size(samples);
+
+    /* Statistics of different block size are not comparable */
+    this->reset_profile();
+
+    uint32_t buffered_effects = 0;
+    for (auto &&effect : this->effects)
+    {
+        if (!effect->supports_block_size(samples))
+            buffered_effects |= 1UL << static_cast<uint8_t>(effect->get_basic_attributes().id);
+    }
 
-    /* Set current read index for input buffer (double buffering) */
-    this->audio_input.sample_index = input - this->audio_input.buffer.begin();
+    this->notify(events::dsp_block_size_changed {samples, buffered_effects});
+}
 
-    /* Transform RAW samples (24bit extended onto 32bit MSB) to normalized DSP buffer */
-    for (unsigned i = this->audio_input.sample_index, j = 0; i < this->audio_input.sample_index + this->audio_input.buffer.size() / 2; i+=2, j+=1)
+void effect_processor::start_audio_stream(void)
+{
+    /* Start audio capture */
+    this->audio.capture(this->audio_input.buffer.data(), 2 * this->block_size * this->audio_input.channels,
+    [this](auto && ...params)
     {
-        constexpr float scale = 1.0f / (1 << (this->audio_input.bps - 1));
-        this->dsp_main_input[j] = (this->audio_input.buffer[i] >> 8) * scale;       // Left
-        this->dsp_aux_input[j] = (this->audio_input.buffer[i + 1] >> 8) * scale;    // Right
-    }
+        this->audio_capture_cb(params...);
+    },
+    true);
+
+    /* Start audio playback */
+    this->audio.play(this->audio_output.buffer.data(), 2 * this->block_size * this->audio_output.channels,
+    [this](auto && ...params)
+    {
+        this->audio_play_cb(params...);
+    },
+    true);
+
+    this->audio_started = true;
+    this->xrun_check_armed = false;
+}
+
+void effect_processor::stop_audio_stream(void)
+{
+    this->audio.stop_capture();
+    this->audio.stop();
+    this->audio_output.buffer.fill(0);
+
+    this->audio_started = false;
+}
+
+void effect_processor::audio_capture_cb(const hal::audio_devices::codec::input_sample_t *input, uint16_t length)
+{
+    /* WARNING: This method could have been called from interrupt */
+
+    /* Set current read index for input buffer (double buffering), samples are converted in audio thread */
+    this->audio_input.sample_index = input - this->audio_input.buffer.begin();
 
     /* Send event to process data */
     static const event e{ events::process_audio {}, true };
@@ -568,24 +1503,372 @@ void effect_processor::audio_play_cb(uint16_t sample_index)
     /* WARNING: This method could have been called from interrupt */
 
     /* Set current write index for output buffer (double buffering) */
-    this->audio_output.sample_index = sample_index - this->audio_output.buffer.size() / 2;
+    this->audio_output.sample_index = sample_index - this->block_size * this->audio_output.channels;
+    this->play_periods.fetch_add(1, std::memory_order_release);
+}
+
+void effect_processor::process_controls(void)
+{
+    /* Limited number of changes per block, rest of them is applied in next blocks */
+    for (uint32_t i = 0; i < control_budget_per_block; i++)
+    {
+        if (!this->waiting_control.has_value())
+        {
+            sequenced_control c;
+            if (!this->control_channel.pop(c))
+                break;
+
+            this->waiting_control = c;
+        }
+
+        /* Changes are applied in order, so the ones sent later wait too */
+        if (!this->is_control_ready(this->waiting_control->sequence))
+            break;
+
+        std::visit([this](auto &&e) { this->event_handler(e); }, this->waiting_control->c);
+        this->waiting_control.reset();
+    }
+}
+
+bool effect_processor::is_control_ready(uint32_t sequence) const
+{
+    /* Chain events sent before change are handled & none of them waits for created effects or staged chain */
+    const bool handled = static_cast<int32_t>(this->chain_events_handled - sequence) >= 0;
+    const bool job_pending = this->is_chain_busy() && static_cast<int32_t>(sequence - this->chain_busy_since) >= 0;
+    return handled && !job_pending;
+}
+
+void effect_processor::reset_profile(void)
+{
+    this->chain_profile.reset();
+    for (auto &&p : this->effect_profile)
+        p.reset();
+}
+
+void effect_processor::handle_overload(bool overrun, uint32_t block_cycles)
+{
+    /* Smoothed block processing time, used to check headroom before restoring */
+    update_average(this->block_cycles_avg, block_cycles);
+
+    if (overrun)
+    {
+        this->clean_blocks = 0;
+
+        if (++this->consecutive_overruns < this->overload_policy.max_consecutive_overruns)
+            return;
+
+        this->consecutive_overruns = 0;
+        this->degrade_effect();
+    }
+    else
+    {
+        this->consecutive_overruns = 0;
+
+        if (this->degraded_count == 0)
+            return;
+
+        const uint32_t recovery_blocks = this->overload_policy.recovery_time_ms * (config::sampling_frequency_hz / 1000) / this->block_size;
+        if (++this->clean_blocks < recovery_blocks)
+            return;
+
+        this->clean_blocks = 0;
+        this->restore_effect();
+    }
+}
+
+void effect_processor::degrade_effect(void)
+{
+    if (this->overload_policy.action == events::overload_action::none)
+        return;
+
+    if (this->overload_policy.action == events::overload_action::lower_quality && this->lower_quality())
+        return;
+
+    /* Find the most expensive active effect */
+    effect *victim = nullptr;
+    uint32_t victim_cycles = 0;
+    for (auto &&effect : this->effects)
+    {
+        if (effect->is_bypassed())
+            continue;
+
+        const uint32_t cycles = this->effect_cycles_avg[static_cast<uint8_t>(effect->get_basic_attributes().id)];
+        if (cycles >= victim_cycles)
+        {
+            victim = effect.get();
+            victim_cycles = cycles;
+        }
+    }
+
+    if (victim == nullptr)
+        return;
+
+    const effect_id id = victim->get_basic_attributes().id;
+    victim->bypass(true);
+    this->degraded_effects[this->degraded_count++] = id;
+
+    this->notify_effect_attributes_changed(victim);
+    this->notify(events::dsp_overload {id, true, this->xruns});
+}
+
+void effect_processor::restore_effect(void)
+{
+    const effect_id id = this->degraded_effects[this->degraded_count - 1];
+    auto effect = this->find_effect(id);
+
+    /* Effect may have been removed or replaced by other chain in the meantime */
+    if (effect == nullptr)
+    {
+        this->degraded_count--;
+        return;
+    }
+
+    /* Restore only if effect fits into remaining headroom (with 1/8 margin) */
+    const uint32_t deadline_cycles = block_deadline_cycles(this->block_size);
+    const uint32_t effect_cycles = this->effect_cycles_avg[static_cast<uint8_t>(id)];
+    if (this->block_cycles_avg + effect_cycles > deadline_cycles - deadline_cycles / 8)
+        return;
+
+    this->degraded_count--;
+    effect->bypass(false);
+
+    this->notify_effect_attributes_changed(effect);
+    this->notify(events::dsp_overload {id, false, this->xruns});
+}
+
+bool effect_processor::is_degraded(effect_id id) const
+{
+    return std::find(this->degraded_effects.begin(), this->degraded_effects.begin() + this->degraded_count, id) !=
+           this->degraded_effects.begin() + this->degraded_count;
+}
+
+void effect_processor::clear_degraded(effect_id id)
+{
+    auto end = this->degraded_effects.begin() + this->degraded_count;
+    if (std::remove(this->degraded_effects.begin(), end, id) != end)
+        this->degraded_count--;
+}
+
+void effect_processor::govern_quality(void)
+{
+    if (!this->quality_governor.enabled)
+        return;
+
+    /* Decide every 250ms, so that averages settle after previous change */
+    const uint32_t period_blocks = config::sampling_frequency_hz / 4 / this->block_size;
+    if (++this->governor_blocks < period_blocks)
+        return;
+
+    this->governor_blocks = 0;
+
+    /* Raise quality only with 10% hysteresis below target */
+    const uint32_t deadline_cycles = block_deadline_cycles(this->block_size);
+    const uint32_t target_cycles = deadline_cycles / 100 * this->quality_governor.target_load_pct;
+    const uint32_t hysteresis_cycles = deadline_cycles / 10;
+
+    if (this->block_cycles_avg > target_cycles)
+        this->lower_quality();
+    else if (this->block_cycles_avg + hysteresis_cycles < target_cycles)
+        this->raise_quality(target_cycles - hysteresis_cycles - this->block_cycles_avg);
+}
+
+bool effect_processor::lower_quality(void)
+{
+    /* Lower quality of active effect, which gives the largest saving */
+    effect *target = nullptr;
+    uint32_t max_saving = 0;
+    for (auto &&effect : this->effects)
+    {
+        const effect_quality q = effect->get_quality();
+        if (effect->is_bypassed() || q == effect_quality::low || effect->cost_estimate(q) == 0)
+            continue;
+
+        const uint32_t cycles = this->effect_cycles_avg[static_cast<uint8_t>(effect->get_basic_attributes().id)];
+        const uint32_t lower_cycles = this->predict_cycles(effect.get(), static_cast<effect_quality>(static_cast<uint8_t>(q) - 1));
+        const uint32_t saving = cycles > lower_cycles ? cycles - lower_cycles : 0;
+        if (target == nullptr || saving > max_saving)
+        {
+            target = effect.get();
+            max_saving = saving;
+        }
+    }
+
+    if (target == nullptr)
+        return false;
+
+    target->set_quality(static_cast<effect_quality>(static_cast<uint8_t>(target->get_quality()) - 1));
+    return true;
+}
+
+bool effect_processor::raise_quality(uint32_t headroom_cycles)
+{
+    /* Raise quality of active effect, which needs the least additional time (if it fits into headroom) */
+    effect *target = nullptr;
+    uint32_t min_increase = headroom_cycles;
+    for (auto &&effect : this->effects)
+    {
+        const effect_quality q = effect->get_quality();
+        if (effect->is_bypassed() || q == effect_quality::high || effect->cost_estimate(q) == 0)
+            continue;
+
+        const uint32_t cycles = this->effect_cycles_avg[static_cast<uint8_t>(effect->get_basic_attributes().id)];
+        const uint32_t higher_cycles = this->predict_cycles(effect.get(), static_cast<effect_quality>(static_cast<uint8_t>(q) + 1));
+        const uint32_t increase = higher_cycles > cycles ? higher_cycles - cycles : 0;
+        if (increase <= min_increase)
+        {
+            target = effect.get();
+            min_increase = increase;
+        }
+    }
+
+    if (target == nullptr)
+        return false;
+
+    target->set_quality(static_cast<effect_quality>(static_cast<uint8_t>(target->get_quality()) + 1));
+    return true;
+}
+
+uint32_t effect_processor::predict_cycles(const effect *e, effect_quality level) const
+{
+    /* Measured cost scaled by ratio of effect's estimates */
+    const uint32_t current_cost = e->cost_estimate(e->get_quality());
+    const uint32_t cycles = this->effect_cycles_avg[static_cast<uint8_t>(e->get_basic_attributes().id)];
+    return current_cost ? static_cast<uint64_t>(cycles) * e->cost_estimate(level) / current_cost : cycles;
 }
 
 uint8_t effect_processor::get_processing_load(void)
 {
-    constexpr uint32_t max_processing_time_us = 1e6 * config::dsp_buffer_size / config::sampling_frequency_hz;
+    const uint32_t max_processing_time_us = 1000000ull * this->block_size / config::sampling_frequency_hz;
     return 100 * this->processing_time_us / max_processing_time_us;
 }
 
+void effect_factory::dispatch(const event &e)
+{
+    std::visit([this](auto &&e) { this->event_handler(e); }, e.data);
+}
+
+void effect_factory::event_handler(const effect_factory_events::create &e)
+{
+    auto instance = create(e.id);
+    instance->warm_up();
+    this->notify({instance.release(), effect_factory_events::created::purpose::add, 0});
+}
+
+void effect_factory::event_handler(const effect_factory_events::prepare &e)
+{
+    auto instance = create(e.id);
+    instance->bypass(e.bypassed);
+
+    /* Controls are listed in the same order as effect IDs */
+    if (static_cast<effect_id>(e.ctrl.index()) == e.id)
+        apply_effect_controls(instance.get(), e.ctrl);
+
+    instance->warm_up();
+    this->notify({instance.release(), effect_factory_events::created::purpose::stage, e.slot});
+}
+
+void effect_factory::event_handler(const effect_factory_events::destroy &e)
+{
+    delete e.instance;
+}
+
+void effect_factory::event_handler(const effect_factory_events::renew &e)
+{
+    auto instance = create(e.id);
+    instance->bypass(e.bypassed);
+    instance->set_quality(e.quality);
+    apply_effect_controls(instance.get(), e.ctrl);
+    instance->warm_up();
+    this->notify({instance.release(), effect_factory_events::created::purpose::renew, 0});
+}
+
 //-----------------------------------------------------------------------------
 /* public */
 
+effect_factory::effect_factory() : actor("effect_factory", configTASK_PRIO_LOW, 4096, effect_factory_event_slots)
+{
+
+}
+
+std::unique_ptr<effect> effect_factory::create(effect_id id)
+{
+    return create_effect(id);
+}
+
 effect_processor::effect_processor() :
 audio{middlewares::i2c_managers::main::get_instance()},
 usb_audio {audio.get_input_volume_range(0), audio.get_output_volume_range()}
 {
     this->processing_time_us = 0;
     this->usb_direct_mon = false;
+    this->block_size = config::dsp_buffer_size;
+    this->audio_started = false;
+
+    this->play_periods = 0;
+    this->last_play_period = 0;
+    this->xrun_check_armed = false;
+    this->xruns = 0;
+
+    /* Overload handling & quality governor change user's sound, so they're off until enabled by event */
+    this->overload_policy = {events::overload_action::none, 4, 5000};
+    this->consecutive_overruns = 0;
+    this->clean_blocks = 0;
+    this->block_cycles_avg = 0;
+    this->degraded_count = 0;
+
+    this->quality_governor = {false, 85};
+    this->governor_blocks = 0;
+    this->effect_cycles_avg.fill(0);
+    this->effect_sleep.fill({});
+
+    /* Chains never reallocate when effect is spliced or chains are swapped */
+    this->effects.reserve(static_cast<uint8_t>(effect_id::_count));
+    this->effect_table.fill(nullptr);
+    this->staged_effects.reserve(static_cast<uint8_t>(effect_id::_count));
+    this->fading_effects.reserve(static_cast<uint8_t>(effect_id::_count));
+    this->staged_in_creation = 0;
+    this->chain_commit_pending = false;
+    this->carried_over_slot = 0;
+    this->staged_ids = 0;
+    this->model_switch_slot = 0;
+    this->chain_muted = false;
+    this->fade_from_silence = false;
+    this->crossfade_blocks = 0;
+    this->crossfade_blocks_left = 0;
+
+    this->routing_nodes = 0;
+    this->routing_output = effect_graph::graph_input;
+    this->graph_dirty = true;
+    this->graph_active_effects = 0;
+    this->graph_local_effects = 0;
+
+#ifdef DUAL_CORE_APP
+    this->pipeline_config = {events::pipeline_mode::off, 0};
+    this->pipeline_split = 0;
+    this->pipeline_target = 0;
+    this->pipeline_dirty = false;
+    this->pipeline_blocks = 0;
+    this->pipeline_misses = 0;
+    this->pipeline_path = pipeline_path::local;
+    this->pipeline_fade = 0;
+    this->renew_pending = 0;
+    this->renew_changed.fill(0);
+#endif /* DUAL_CORE_APP */
+    this->effects_in_creation = 0;
+    this->postponed_head = 0;
+    this->postponed_count = 0;
+    this->chain_events_handled = 0;
+    this->chain_busy_since = 0;
+    this->factory.attach([this](effect_factory_events::created c)
+    {
+        /* Called from factory thread, wait until audio thread takes previously created effects */
+        while (!this->created_effects.push(c))
+            vTaskDelay(1);
+
+        /* Immutable event doesn't need pool slot (all of them may be held by postponed events) */
+        static const event created_event { events::effect_created {}, true };
+        this->send(created_event);
+    });
 
     this->send({events::initialize {}});
 }
@@ -595,4 +1878,14 @@ effect_processor::~effect_processor()
 
 }
 
+void effect_processor::send_control(const events::control &c)
+{
+    /* Change is tagged with number of chain events sent so far, it's not applied before them */
+    const sequenced_control sc {c, this->chain_events_sent.load(std::memory_order_acquire)};
+
+    /* Channel full: wait for audio thread to drain it (keeps order of changes) */
+    while (!this->control_channel.push(sc))
+        vTaskDelay(1);
+}
+
 
@@ -12,13 +12,20 @@
 #include <variant>
 #include <memory>
 #include <array>
+#include <atomic>
+#include <optional>
 
 #include <middlewares/actor.hpp>
 #include <middlewares/usb/usb_audio.hpp>
 
+#include <libs/fast_queue.hpp>
+#include <libs/cycle_stats.hpp>
+
 #include <hal_audio.hpp>
 
 #include "effect_interface.hpp"
+#include "effect_graph.hpp"
+#include "dsp_pipeline.hpp"
 
 namespace mfx
 {
@@ -50,6 +57,7 @@ struct configuration
     bool mic_routed_to_aux;
     bool usb_audio_if_enabled;
     bool usb_direct_mon_enabled;
+    uint16_t dsp_block_size;
 };
 
 struct start_audio
@@ -67,6 +75,11 @@ struct get_dsp_load
 
 };
 
+struct get_dsp_profile
+{
+    bool reset; // Clear statistics after printing
+};
+
 struct add_effect
 {
     effect_id id;
@@ -120,9 +133,36 @@ struct enable_usb_direct_mon
     bool value;
 };
 
+struct set_dsp_block_size
+{
+    uint16_t samples;
+};
+
+/* Action taken when audio processing repeatedly misses its deadline */
+enum class overload_action : uint8_t
+{
+    none,
+    bypass_effect, // Temporarily bypass the most expensive active effect
+    lower_quality // Lower quality of the most expensive effect, bypass it if no effect can be lowered
+};
+
+struct set_overload_policy
+{
+    overload_action action;
+    uint8_t max_consecutive_overruns; // Number of overrun blocks in a row, which triggers degradation
+    uint16_t recovery_time_ms; // Time without overruns, after which degraded effect is restored
+};
+
+struct set_quality_governor
+{
+    bool enabled;
+    uint8_t target_load_pct; // Quality levels of effects are raised/lowered to keep DSP load under this value
+};
+
 struct set_effect_controls
 {
     effect_controls ctrl;
+    controls_mask changed {all_controls}; // Fields of controls which are applied (e.g. only turned knob)
 };
 
 struct get_effect_attributes
@@ -135,9 +175,104 @@ struct enumerate_effects_attributes
 
 };
 
+/* Effects of new chain are staged (created & warmed up off the audio path) & swapped in at once by commit_chain */
+struct stage_effect
+{
+    effect_id id;
+    bool bypassed;
+    effect_controls ctrl;
+};
+
+struct commit_chain
+{
+    uint8_t crossfade_blocks; // Number of blocks, over which old chain is faded out & new one faded in
+};
+
+/* Routing of effects as graph (effects of chain are referred by ID, the ones not used in graph are not processed) */
+struct set_routing
+{
+    std::array<route_node, effect_graph::max_nodes> nodes;
+    uint8_t count; // 0 - linear chain (default)
+    uint8_t output; // Node feeding audio output
+};
+
+/* Dual-core pipeline: last effects of linear chain are processed by CM4 (one block later, adds one block of latency) */
+enum class pipeline_mode : uint8_t
+{
+    off,
+    manual, // Fixed number of last effects runs on CM4
+    automatic // Split is chosen by measured cost of effects on both cores
+};
+
+struct set_dsp_pipeline
+{
+    pipeline_mode mode;
+    uint8_t cm4_effects; // Manual mode: number of last effects of chain processed by CM4
+};
+
+struct effect_created
+{
+    /* Sent by effect factory when constructed effect is ready to be taken from handoff queue */
+};
+
 struct dsp_load_changed
 {
     uint8_t load_pct;
+    uint8_t cm4_load_pct; // Load of CM4 by pipelined effects (0 if pipeline is not used)
+};
+
+struct dsp_overload
+{
+    effect_id id; // Degraded or restored effect
+    bool degraded; // true - effect degraded due to overruns, false - effect restored
+    uint32_t xruns; // Total number of xruns since audio start
+};
+
+/* Snapshot of processing time statistics [us], it's printed outside of audio thread */
+struct dsp_time_stats
+{
+    float min, avg, p50, p99, p999, max;
+    uint32_t misses;
+};
+
+/* DSP profile is reported as summary followed by one event per effect of chain */
+struct dsp_profile_summary
+{
+    uint32_t blocks;
+    uint16_t block_size;
+    float budget_us;
+    dsp_time_stats total;
+    uint32_t xruns;
+    bool cm4_active; // Last effects of chain are pipelined to CM4
+    uint8_t cm4_load_pct;
+    uint32_t cm4_misses;
+};
+
+struct dsp_profile_effect
+{
+    effect_id id;
+    std::optional<effect_quality> quality; // Empty if effect has single quality level
+    bool on_cm4; // Effect runs on CM4, only average time (measured on CM4) is valid
+    dsp_time_stats time;
+};
+
+struct dsp_block_size_changed
+{
+    uint16_t samples;
+    uint32_t buffered_effects; // Bit per effect ID, effects buffered to fixed block (add latency)
+};
+
+struct routing_changed
+{
+    bool accepted; // false - routing rejected (cycle, invalid node or too many parallel branches)
+    uint8_t nodes;
+    uint8_t buffers;
+};
+
+struct dsp_pipeline_changed
+{
+    pipeline_mode mode;
+    bool supported; // false - single core build
 };
 
 struct effect_attributes_changed
@@ -200,6 +335,7 @@ using incoming = std::variant
     start_audio,
     process_audio,
     get_dsp_load,
+    get_dsp_profile,
     add_effect,
     remove_effect,
     move_effect,
@@ -210,29 +346,159 @@ using incoming = std::variant
     set_mute,
     enable_usb_audio_if,
     enable_usb_direct_mon,
+    set_dsp_block_size,
+    set_overload_policy,
+    set_quality_governor,
     set_effect_controls,
     get_effect_attributes,
-    enumerate_effects_attributes
+    enumerate_effects_attributes,
+    stage_effect,
+    commit_chain,
+    set_routing,
+    set_dsp_pipeline,
+    effect_created
+>;
+
+/* Parameter changes of existing effects, which can be passed via control channel */
+using control = std::variant
+<
+    bypass_effect,
+    set_effect_controls
 >;
 
+/* Events which don't depend on effects chain, they are not postponed while new effect is being created */
+template<typename T>
+constexpr bool is_chain_independent(void)
+{
+    return std::is_same_v<T, process_audio> || std::is_same_v<T, get_dsp_load> ||
+           std::is_same_v<T, effect_created> || std::is_same_v<T, ipc_data> ||
+           std::is_same_v<T, set_input_volume> || std::is_same_v<T, set_output_volume> ||
+           std::is_same_v<T, set_mute> || std::is_same_v<T, route_mic_to_aux> ||
+           std::is_same_v<T, enable_usb_audio_if> || std::is_same_v<T, enable_usb_direct_mon>;
+}
+
+inline bool is_chain_event(const incoming &e)
+{
+    return std::visit([](auto &&e) { return !is_chain_independent<std::decay_t<decltype(e)>>(); }, e);
+}
+
 using outgoing = std::variant
 <
     volume_range_info,
     dsp_load_changed,
+    dsp_overload,
     mute_changed,
     input_volume_changed,
     output_volume_changed,
     effect_attributes_changed,
-    effect_attributes_enumerated
+    effect_attributes_enumerated,
+    dsp_profile_summary,
+    dsp_profile_effect,
+    dsp_block_size_changed,
+    routing_changed,
+    dsp_pipeline_changed
 >;
 
 }
 
+/* Events are copied into slots owned by actor, so realtime thread does not use heap allocator */
+constexpr inline uint32_t effect_processor_event_slots {32};
+
+namespace effect_factory_events
+{
+
+struct create
+{
+    effect_id id;
+};
+
+struct prepare
+{
+    effect_id id;
+    bool bypassed;
+    effect_controls ctrl;
+    uint8_t slot; // Position in staged chain
+};
+
+struct destroy
+{
+    effect *instance;
+};
+
+/* Fresh instance replaces one with stale state (e.g. effect which was processed by CM4 for a while) */
+struct renew
+{
+    effect_id id;
+    bool bypassed;
+    effect_controls ctrl;
+    effect_quality quality;
+};
+
+using incoming = std::variant
+<
+    create,
+    prepare,
+    destroy,
+    renew
+>;
+
+/* Effect handed over by factory */
+struct created
+{
+    effect *instance;
+    enum class purpose : uint8_t { add, stage, renew } purpose; // Added to chain, prepared for staged chain (at given slot) or renewed
+    uint8_t slot;
+};
+
+}
+
+/* Every effect can be created, prepared for staged chain, renewed & destroyed at the same time */
+constexpr inline uint32_t effect_factory_event_slots {4 * static_cast<uint8_t>(effect_id::_count)};
+
+/*
+ * Low priority worker which constructs & destroys effects, so that audio thread is not stalled
+ * by allocation & initialization of delay lines, filters or models. Created (and warmed up) effect
+ * is passed to attached callback (called from worker thread).
+ */
+class effect_factory : public middlewares::actor<effect_factory_events::incoming, effect_factory_events::created, effect_factory_event_slots>
+{
+public:
+    effect_factory();
+
+    static std::unique_ptr<effect> create(effect_id id);
+
+private:
+    void dispatch(const event &e) override;
+
+    void event_handler(const effect_factory_events::create &e);
+    void event_handler(const effect_factory_events::prepare &e);
+    void event_handler(const effect_factory_events::destroy &e);
+    void event_handler(const effect_factory_events::renew &e);
+};
+
 class effect_processor_base : public middlewares::actor<effect_processor_events::incoming,
-                                                        effect_processor_events::outgoing>
+                                                        effect_processor_events::outgoing,
+                                                        effect_processor_event_slots>
 {
 public:
-    effect_processor_base() : actor("effect_processor", configTASK_PRIO_REALTIME, 4096) {}
+    effect_processor_base() : actor("effect_processor", configTASK_PRIO_REALTIME, 4096, effect_processor_event_slots) {}
+
+    /* Events which depend on effects chain are counted, so that parameter changes sent later don't overtake them */
+    void send(const event &e, uint32_t timeout = portMAX_DELAY)
+    {
+        if (effect_processor_events::is_chain_event(e.data))
+            this->chain_events_sent.fetch_add(1, std::memory_order_release);
+
+        actor::send(e, timeout);
+    }
+
+    /* Send parameter change (by default it goes through event queue, like other events) */
+    virtual void send_control(const effect_processor_events::control &c)
+    {
+        std::visit([this](auto &&e) { this->send({e}); }, c);
+    }
+protected:
+    std::atomic<uint32_t> chain_events_sent {0};
 private:
     virtual void dispatch(const event &e) {};
 };
@@ -243,8 +509,22 @@ public:
     effect_processor();
     ~effect_processor();
 
+    /* Send parameter change via control channel (must be called from one thread only) */
+    void send_control(const effect_processor_events::control &c) override;
+
 private:
+    typedef std::array<dsp_buffer*, effect_graph::max_buffers> graph_buffers;
+
+    struct sequenced_control
+    {
+        effect_processor_events::control c;
+        uint32_t sequence; // Number of chain events sent before change
+    };
+
     void dispatch(const event &e) override;
+    void handle_chain_event(const effect_processor_events::incoming &e);
+    void process_controls(void);
+    bool is_control_ready(uint32_t sequence) const;
 
     /* Event handlers */
     void event_handler(const effect_processor_events::initialize &e);
@@ -262,40 +542,82 @@ private:
     void event_handler(const effect_processor_events::route_mic_to_aux &e);
     void event_handler(const effect_processor_events::enable_usb_audio_if &e);
     void event_handler(const effect_processor_events::enable_usb_direct_mon &e);
+    void event_handler(const effect_processor_events::set_dsp_block_size &e);
+    void event_handler(const effect_processor_events::set_overload_policy &e);
+    void event_handler(const effect_processor_events::set_quality_governor &e);
     void event_handler(const effect_processor_events::process_audio &e);
     void event_handler(const effect_processor_events::get_dsp_load &e);
+    void event_handler(const effect_processor_events::get_dsp_profile &e);
     void event_handler(const effect_processor_events::set_effect_controls &e);
     void event_handler(const effect_processor_events::get_effect_attributes &e);
     void event_handler(const effect_processor_events::enumerate_effects_attributes &e);
-
-    void set_controls(const tuner_attr::controls &ctrl);
-    void set_controls(const tremolo_attr::controls &ctrl);
-    void set_controls(const echo_attr::controls &ctrl);
-    void set_controls(const chorus_attr::controls &ctrl);
-    void set_controls(const reverb_attr::controls &ctrl);
-    void set_controls(const overdrive_attr::controls &ctrl);
-    void set_controls(const cabinet_sim_attr::controls &ctrl);
-    void set_controls(const vocoder_attr::controls &ctrl);
-    void set_controls(const phaser_attr::controls &ctrl);
-    void set_controls(const amp_sim_attr::controls &ctrl);
-    void set_controls(const neural_amp_modeler_attr::controls &ctrl);
+    void event_handler(const effect_processor_events::stage_effect &e);
+    void event_handler(const effect_processor_events::commit_chain &e);
+    void event_handler(const effect_processor_events::set_routing &e);
+    void event_handler(const effect_processor_events::set_dsp_pipeline &e);
+    void event_handler(const effect_processor_events::effect_created &e);
 
     void notify_effect_attributes_changed(const effect *eff);
 
-    std::unique_ptr<effect> create_new(effect_id id);
+    bool take_created_effects(void);
+    void splice_effect(effect *instance);
+    void swap_chain(void);
+    void release_chain(std::vector<std::unique_ptr<effect>> &chain);
+    void crossfade(effect::dsp_output &out_l, effect::dsp_output &out_r, bool &stereo);
+    void mute_chain(effect::dsp_output &out_l, effect::dsp_output &out_r, bool stereo);
+    void switch_model(void);
+    bool is_chain_busy(void) const;
+    bool compile_graph(effect_graph &g, const std::vector<std::unique_ptr<effect>> &chain, uint8_t local, bool routed);
+    uint8_t run_graph(const effect_graph &g, const graph_buffers &left, const graph_buffers &right,
+                      std::array<bool, effect_graph::max_buffers> &stereo, bool profiled);
+    void update_graph(void);
+    uint8_t local_effects(void) const;
+    void update_pipeline(void);
+    uint8_t process_pipeline(const graph_buffers &left, const graph_buffers &right, uint8_t result, bool &stereo);
+    uint8_t process_pipeline_tail(const graph_buffers &left, const graph_buffers &right, uint8_t result, bool &stereo);
+    void renew_effect(effect *instance);
+    uint8_t balance_pipeline(uint8_t first_offloadable) const;
+    bool process_effect(effect &e, const effect::dsp_input &in_l, const effect::dsp_input &in_r, bool input_stereo,
+                        effect::dsp_output &out_l, effect::dsp_output &out_r, bool input_silent);
+    void postpone_event(const event &e);
+    void replay_postponed_events(void);
     bool find_effect(effect_id id, std::vector<std::unique_ptr<effect>>::iterator &it);
-    effect* find_effect(effect_id id);
+    effect* find_effect(effect_id id) const;
+    void index_effects(void);
+
+    void set_block_size(uint16_t samples);
+    void start_audio_stream(void);
+    void stop_audio_stream(void);
 
     void audio_capture_cb(const hal::audio_devices::codec::input_sample_t *input, uint16_t length);
     void audio_play_cb(uint16_t sample_index);
 
     uint8_t get_processing_load(void);
+    void reset_profile(void);
+
+    void handle_overload(bool overrun, uint32_t block_cycles);
+    void degrade_effect(void);
+    void restore_effect(void);
+    bool is_degraded(effect_id id) const;
+    void clear_degraded(effect_id id);
+
+    void govern_quality(void);
+    bool lower_quality(void);
+    bool raise_quality(uint32_t headroom_cycles);
+    uint32_t predict_cycles(const effect *e, effect_quality level) const;
 
     std::vector<std::unique_ptr<effect>> effects;
 
+    /* Effects of current chain indexed by ID (position in chain is found only by structural changes) */
+    std::array<effect*, static_cast<uint8_t>(effect_id::_count)> effect_table;
+
     hal::audio_devices::codec audio;
-    hal::audio_devices::codec::input_buffer_t<2 * config::dsp_buffer_size> audio_input;
-    hal::audio_devices::codec::output_buffer_t<2 * config::dsp_buffer_size> audio_output;
+    hal::audio_devices::codec::input_buffer_t<2 * config::dsp_max_buffer_size> audio_input;
+    hal::audio_devices::codec::output_buffer_t<2 * config::dsp_max_buffer_size> audio_output;
+
+    /* Current block size (samples per channel), half of audio buffers is used for double buffering */
+    uint16_t block_size;
+    bool audio_started;
 
 
     effect::dsp_input dsp_main_input;
@@ -304,8 +626,132 @@ private:
 
     uint32_t processing_time_us;
 
+    /* Cycle statistics of whole audio block & of each effect (indexed by effect ID) */
+    libs::cycle_stats chain_profile;
+    std::array<libs::cycle_stats, static_cast<uint8_t>(effect_id::_count)> effect_profile;
+
+    /* Xrun detection: playback DMA should consume exactly one half of output buffer between consecutive blocks */
+    std::atomic<uint32_t> play_periods;
+    uint32_t last_play_period;
+    bool xrun_check_armed;
+    uint32_t xruns;
+
+    /* Overload handling, degraded effects are kept on stack (last degraded is restored first) */
+    effect_processor_events::set_overload_policy overload_policy;
+    uint32_t consecutive_overruns;
+    uint32_t clean_blocks;
+    uint32_t block_cycles_avg;
+    std::array<effect_id, static_cast<uint8_t>(effect_id::_count)> degraded_effects;
+    uint8_t degraded_count;
+
+    /* DSP load governor, quality changes are based on smoothed cost of each effect (indexed by effect ID) */
+    effect_processor_events::set_quality_governor quality_governor;
+    uint32_t governor_blocks;
+    std::array<uint32_t, static_cast<uint8_t>(effect_id::_count)> effect_cycles_avg;
+
+    /* Effect is asleep (not processed) when its input was silent for at least its tail length & output is silent */
+    struct sleep_state
+    {
+        uint32_t silent_samples;
+        bool output_silent;
+    };
+    std::array<sleep_state, static_cast<uint8_t>(effect_id::_count)> effect_sleep;
+
     bool usb_direct_mon;
     middlewares::usb_audio usb_audio;
+
+    /*
+     * Effects are created by factory & handed over through lock-free queue. Until they are spliced into chain,
+     * events which may refer to them are postponed (processed later in original order). Postponed event keeps its
+     * slot of actor's pool, so there is always room for it & senders are blocked when pool is exhausted.
+     */
+    effect_factory factory;
+    libs::fast_queue<effect_factory_events::created, 3 * static_cast<uint8_t>(effect_id::_count)> created_effects;
+    std::array<const event*, effect_processor_event_slots> postponed_events;
+    uint8_t postponed_head;
+    uint8_t postponed_count;
+    uint8_t effects_in_creation;
+
+    /*
+     * Chain swap: staged chain is filled by factory & replaces current one when complete, old chain is still
+     * processed by its own graph (on copy of input) & crossfaded with new one. Effect with global state (NAM
+     * weights) can't have second instance: if it keeps its model, it's moved from current chain to the staged one
+     * on swap (chains are switched without crossfade). Otherwise current chain is faded out & muted, while
+     * factory destroys old instance & prepares new one, then new chain is faded in from silence.
+     */
+    std::vector<std::unique_ptr<effect>> staged_effects;
+    std::vector<std::unique_ptr<effect>> fading_effects;
+    uint32_t staged_ids; // Bit per effect ID
+    uint8_t staged_in_creation;
+    bool chain_commit_pending;
+    std::optional<effect_processor_events::stage_effect> carried_over;
+    uint8_t carried_over_slot;
+    std::optional<effect_processor_events::stage_effect> model_switch;
+    uint8_t model_switch_slot;
+    bool chain_muted;
+    bool fade_from_silence;
+    uint8_t crossfade_blocks;
+    uint8_t crossfade_blocks_left;
+    effect_graph fading_graph;
+    std::array<dsp_buffer, effect_graph::max_buffers> dsp_fade_buffers;
+    std::array<dsp_buffer, effect_graph::max_buffers> dsp_fade_right_buffers;
+
+    /*
+     * Chain is executed as graph (linear one unless routing is set), plan is rebuilt when routing, chain
+     * or set of active effects changes. Main input & output are first two buffers, rest is for branches.
+     */
+    effect_graph graph;
+    std::array<route_node, effect_graph::max_nodes> routing;
+    uint8_t routing_nodes;
+    uint8_t routing_output;
+    bool graph_dirty;
+    uint32_t graph_active_effects;
+    uint8_t graph_local_effects; // Linear chain: number of first effects processed by this core
+    std::array<dsp_buffer, effect_graph::max_buffers - 2> dsp_branch_buffers;
+
+    /*
+     * Right channels of graph buffers, used only while buffer holds stereo signal. Signal is mono up to first
+     * stereo effect, mono effects in stereo part of graph process only mid signal (side is passed around them).
+     */
+    std::array<dsp_buffer, effect_graph::max_buffers> dsp_right_buffers;
+    dsp_buffer dsp_side;
+    std::array<int32_t, config::dsp_max_buffer_size> dsp_right_q31;
+
+#ifdef DUAL_CORE_APP
+    /*
+     * Dual-core pipeline: effects from split to the end of linear chain are processed by CM4 on previous block
+     * (CM7 keeps their instances as source of controls). Until CM4 stage is ready, CM7 processes whole chain.
+     */
+    dsp_pipeline pipeline;
+    effect_processor_events::set_dsp_pipeline pipeline_config;
+    uint8_t pipeline_split; // Split of configured CM4 stage
+    uint8_t pipeline_target; // Split chosen by manual or automatic mode
+    bool pipeline_dirty;
+    uint32_t pipeline_blocks;
+    uint32_t pipeline_misses;
+
+    /*
+     * Output is taken from CM7 only or via CM4 (both one block late, so latency doesn't change). When CM4 stage
+     * starts or stops, CM7 processes whole chain too & outputs are crossfaded (fade position in blocks, 0 - CM7 only).
+     * CM7 instances of pipelined effects are renewed, so they don't replay stale state when they return to CM7.
+     */
+    enum class pipeline_path : uint8_t { local, entering, pipelined, leaving } pipeline_path;
+    uint8_t pipeline_fade;
+    uint32_t renew_pending; // Bit per effect ID
+    std::array<controls_mask, static_cast<uint8_t>(effect_id::_count)> renew_changed; // Controls changed meanwhile
+#endif /* DUAL_CORE_APP */
+
+    /*
+     * Lock-free SPSC channel of parameter changes, drained at the beginning of each audio block. Change waits only
+     * for chain events sent before it (e.g. effect which is being added), changes of existing effects are applied
+     * while unrelated effect is being created. Handled chain events are counted like sent ones.
+     */
+    constexpr static size_t control_channel_size = 32;
+    constexpr static uint32_t control_budget_per_block = 4;
+    libs::fast_queue<sequenced_control, control_channel_size> control_channel;
+    std::optional<sequenced_control> waiting_control;
+    uint32_t chain_events_handled;
+    uint32_t chain_busy_since; // Number of chain event, which started pending creation of effects or chain swap
 };
 
 }
@@ -147,13 +147,15 @@ void neural_amp_modeler::process(const dsp_input& in, dsp_output& out)
         float *in_ptrs[NAM_IN_CHANNELS];
         float *out_ptrs[NAM_OUT_CHANNELS];
 
-        in_ptrs[0] = const_cast<float*>(in.data());
-        out_ptrs[0] = out.data();
-        nam_process(&this->nam_state, static_cast<const float* const*>(in_ptrs), out_ptrs, mfx::config::dsp_buffer_size / 2);
-
-        in_ptrs[0] = const_cast<float*>(in.data() + mfx::config::dsp_buffer_size / 2);
-        out_ptrs[0] = out.data() + mfx::config::dsp_buffer_size / 2;
-        nam_process(&this->nam_state, static_cast<const float* const*>(in_ptrs), out_ptrs, mfx::config::dsp_buffer_size / 2);
+        /* Model is run in chunks of at most half of default block */
+        constexpr uint32_t chunk_size = mfx::config::dsp_buffer_size / 2;
+        for (uint32_t i = 0; i < in.size(); i += chunk_size)
+        {
+            const uint32_t len = std::min<uint32_t>(chunk_size, in.size() - i);
+            in_ptrs[0] = const_cast<float*>(in.data() + i);
+            out_ptrs[0] = out.data() + i;
+            nam_process(&this->nam_state, static_cast<const float* const*>(in_ptrs), out_ptrs, len);
+        }
 
         std::transform(out.begin(), out.end(), out.begin(),
         [this](auto input)
@@ -172,6 +174,18 @@ const effect_specific_attr neural_amp_modeler::get_specific_attributes(void) con
     return this->attr;
 }
 
+uint32_t neural_amp_modeler::tail_length(void) const
+{
+    /* Receptive field of model */
+    return prewarm_samples;
+}
+
+void neural_amp_modeler::warm_up(void)
+{
+    /* Fill whole receptive field at once, instead of one chunk per processed block */
+    while (!this->prewarm(prewarm_samples));
+    this->model_ready = true;
+}
 
 void neural_amp_modeler::set_model(uint8_t idx)
 {
@@ -28,6 +28,8 @@ public:
 
     void process(const dsp_input &in, dsp_output &out) override;
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
+    void warm_up(void) override;
 
     void set_model(uint8_t idx);
     void set_input_volume(float vol);
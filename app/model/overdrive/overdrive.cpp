@@ -7,8 +7,11 @@
 
 #include "overdrive.hpp"
 
+#include <libs/fast_math.hpp>
+
 #include <cmath>
 #include <algorithm>
+#include <utility>
 
 using namespace mfx;
 
@@ -18,6 +21,9 @@ using namespace mfx;
 namespace
 {
 
+/* Use fast approximation of exp() in soft clipper (max rel. error 7.9e-5) */
+constexpr bool fast_math {false};
+
 }
 
 //-----------------------------------------------------------------------------
@@ -46,7 +52,24 @@ float overdrive::hard_clip(float in)
 
 float overdrive::soft_clip(float in)
 {
-    return libs::adsp::sgn(in) * (1 - std::exp(-std::abs(in)));
+    if constexpr (fast_math)
+        return libs::adsp::sgn(in) * (1 - libs::adsp::fastmath::exp<libs::adsp::fastmath::precision::low>(-std::abs(in)));
+    else
+        return libs::adsp::sgn(in) * (1 - std::exp(-std::abs(in)));
+}
+
+template<typename shaper, uint8_t order>
+void overdrive::adaa_clip(libs::adsp::adaa<shaper, order> &clipper, float *samples, uint32_t n)
+{
+    const float gain = this->attr.ctrl.gain;
+    const float mix = this->attr.ctrl.mix;
+
+    /* Dry signal is taken from ADAA kernel to stay aligned with its half-sample delay */
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const float sample = clipper.process(samples[i] * gain);
+        samples[i] = mix * sample + (1.0f - mix) * clipper.dry() / gain;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -54,6 +77,8 @@ float overdrive::soft_clip(float in)
 
 
 overdrive::overdrive() : effect { effect_id::overdrive },
+oversampler { default_oversampling_factor },
+antialiasing_order { 0 },
 attr {}
 {
     const auto& def = overdrive_attr::default_ctrl;
@@ -63,6 +88,8 @@ attr {}
     this->set_high(def.high);
     this->set_gain(def.gain);
     this->set_mix(def.mix);
+
+    this->quality = effect_quality::medium;
 }
 
 overdrive::~overdrive()
@@ -72,29 +99,35 @@ overdrive::~overdrive()
 
 void overdrive::process(const dsp_input& in, dsp_output& out)
 {
-    /* 1. Apply 1-st order high-pass IIR filter (in-place) */
-    this->iir_hp.process(in.data(), const_cast<float*>(in.data()), in.size());
+    /* 1. Apply 1-st order high-pass IIR filter (into output, input is not modified) */
+    this->iir_hp.process(in.data(), out.data(), in.size());
 
-    /* 2. Interpolate */
-    this->intrpl.process(const_cast<float*>(in.data()), this->sample_buffer.data());
-
-    std::transform(this->sample_buffer.begin(), this->sample_buffer.end(), this->sample_buffer.begin(),
-    [this](auto input)
+    /* 2. Interpolate, 3. apply gain, clip & mix at oversampled rate, 4. decimate (in-place) */
+    this->oversampler.process(out.data(), out.data(), out.size(),
+    [this](float *samples, uint32_t n)
     {
-        /* 3. Apply gain, clip & mix */
-        float sample;
-        if (this->attr.ctrl.mode == overdrive_attr::controls::mode_type::hard)
-            sample = this->hard_clip(input * this->attr.ctrl.gain);
-        else
-            sample = this->soft_clip(input * this->attr.ctrl.gain);
-
-        return this->attr.ctrl.mix * sample + (1.0f - this->attr.ctrl.mix) * input;
+        const bool hard = this->attr.ctrl.mode == overdrive_attr::controls::mode_type::hard;
+
+        if (this->antialiasing_order == 1)
+            return hard ? this->adaa_clip(this->hard_adaa1, samples, n) : this->adaa_clip(this->soft_adaa1, samples, n);
+        else if (this->antialiasing_order == 2)
+            return hard ? this->adaa_clip(this->hard_adaa2, samples, n) : this->adaa_clip(this->soft_adaa2, samples, n);
+
+        std::transform(samples, samples + n, samples,
+        [this](auto input)
+        {
+            float sample;
+            if (this->attr.ctrl.mode == overdrive_attr::controls::mode_type::hard)
+                sample = this->hard_clip(input * this->attr.ctrl.gain);
+            else
+                sample = this->soft_clip(input * this->attr.ctrl.gain);
+
+            return this->attr.ctrl.mix * sample + (1.0f - this->attr.ctrl.mix) * input;
+        }
+        );
     }
     );
 
-    /* 4. Decimate */
-    this->decim.process(this->sample_buffer.data(), out.data());
-
     /* 5. Apply 2-nd order low-pass IIR filter (in-place) */
     this->iir_lp.process(out.data(), out.data(), out.size());
 }
@@ -104,6 +137,12 @@ const effect_specific_attr overdrive::get_specific_attributes(void) const
     return this->attr;
 }
 
+uint32_t overdrive::tail_length(void) const
+{
+    /* Only short IIR & half-band filters */
+    return config::sampling_frequency_hz / 100;
+}
+
 void overdrive::set_high(float high)
 {
     high = std::clamp(high, 0.0f, 1.0f);
@@ -162,4 +201,50 @@ void overdrive::set_mode(overdrive_attr::controls::mode_type mode)
     this->attr.ctrl.mode = mode;
 }
 
+void overdrive::set_oversampling(uint8_t factor)
+{
+    factor = std::clamp<uint8_t>(factor, 1, max_oversampling_factor);
+
+    if (this->oversampler.get_factor() == factor)
+        return;
+
+    this->oversampler.set_factor(factor);
+}
+
+void overdrive::set_quality(effect_quality level)
+{
+    /* Low: 1st order ADAA without oversampling, medium: x2 oversampling, high: x4 oversampling */
+    constexpr std::array<std::pair<uint8_t, uint8_t>, static_cast<uint8_t>(effect_quality::_count)> levels
+    {{
+        {1, 1},
+        {default_oversampling_factor, 0},
+        {max_oversampling_factor, 0},
+    }};
+
+    const auto [factor, order] = levels.at(static_cast<uint8_t>(level));
+    this->set_oversampling(factor);
+    this->set_antialiasing(order);
+    this->quality = level;
+}
+
+uint32_t overdrive::cost_estimate(effect_quality level) const
+{
+    /* Dominated by half-band filters & clipper running at oversampled rate */
+    constexpr std::array<uint32_t, static_cast<uint8_t>(effect_quality::_count)> cost {2, 5, 10};
+    return cost.at(static_cast<uint8_t>(level));
+}
+
+void overdrive::set_antialiasing(uint8_t order)
+{
+    order = std::clamp<uint8_t>(order, 0, 2);
 
+    if (this->antialiasing_order == order)
+        return;
+
+    this->hard_adaa1.reset();
+    this->hard_adaa2.reset();
+    this->soft_adaa1.reset();
+    this->soft_adaa2.reset();
+
+    this->antialiasing_order = order;
+}
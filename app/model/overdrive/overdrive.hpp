@@ -25,22 +25,37 @@ public:
 
     void process(const dsp_input &in, dsp_output &out) override;
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
 
     void set_high(float high);
     void set_gain(float gain);
     void set_low(float low);
     void set_mix(float mix);
     void set_mode(overdrive_attr::controls::mode_type mode);
+    void set_oversampling(uint8_t factor);
+    void set_antialiasing(uint8_t order);
+
+    void set_quality(effect_quality level) override;
+    uint32_t cost_estimate(effect_quality level) const override;
 
 private:
     float soft_clip(float in);
     float hard_clip(float in);
 
-    /* Interpolator & decimator for oversampling & decimation*/
-    constexpr static uint8_t oversampling_factor = 2;
-    libs::adsp::interpolator<oversampling_factor, config::dsp_buffer_size> intrpl;
-    libs::adsp::decimator<oversampling_factor, oversampling_factor * config::dsp_buffer_size> decim;
-    std::array<float, oversampling_factor * config::dsp_buffer_size> sample_buffer;
+    template<typename shaper, uint8_t order>
+    void adaa_clip(libs::adsp::adaa<shaper, order> &clipper, float *samples, uint32_t n);
+
+    /* Oversampling of clipper (factor selectable at runtime up to max) */
+    constexpr static uint8_t max_oversampling_factor = 4;
+    constexpr static uint8_t default_oversampling_factor = 2;
+    libs::adsp::oversampler<max_oversampling_factor, config::dsp_max_buffer_size> oversampler;
+
+    /* Antiderivative anti-aliasing of clipper (order selectable at runtime, 0 - disabled) */
+    uint8_t antialiasing_order;
+    libs::adsp::adaa<libs::adsp::hard_clip_shaper, 1> hard_adaa1;
+    libs::adsp::adaa<libs::adsp::hard_clip_shaper, 2> hard_adaa2;
+    libs::adsp::adaa<libs::adsp::soft_clip_shaper, 1> soft_adaa1;
+    libs::adsp::adaa<libs::adsp::soft_clip_shaper, 2> soft_adaa2;
 
     /* Tunable high-pass 2nd order IIR filter */
     libs::adsp::iir_highpass iir_hp;
@@ -9,6 +9,8 @@
 
 #include "app/utils.hpp"
 
+#include <libs/fast_math.hpp>
+
 #include <algorithm>
 
 using namespace mfx;
@@ -19,6 +21,11 @@ using namespace mfx;
 namespace
 {
 
+constexpr float apf_fc = 141;
+
+/* Use fast approximation of tan() for allpass coefficients (max rel. error 3.5e-6) */
+constexpr bool fast_math {false};
+
 }
 
 //-----------------------------------------------------------------------------
@@ -27,7 +34,11 @@ namespace
 float phaser::calc_apf_coeff(float fc, float fs)
 {
     const float wc = fc / fs;
-    const float k = std::tan(libs::adsp::pi * wc);
+    float k;
+    if constexpr (fast_math)
+        k = libs::adsp::fastmath::tan(libs::adsp::pi * wc);
+    else
+        k = std::tan(libs::adsp::pi * wc);
     return (k - 1) / (k + 1);
 }
 
@@ -36,7 +47,8 @@ float phaser::calc_apf_coeff(float fc, float fs)
 
 phaser::phaser() : effect { effect_id::phaser },
 apf_feedback {0},
-lfo { libs::adsp::oscillator::shape::sine, phaser_attr::default_ctrl.rate, config::sampling_frequency_hz },
+lfo { libs::adsp::wavetable_oscillator::shape::sine, phaser_attr::default_ctrl.rate, config::sampling_frequency_hz },
+apf_coeff_mod { calc_apf_coeff(apf_fc, config::sampling_frequency_hz) },
 attr {}
 {
     const auto& def = phaser_attr::default_ctrl;
@@ -53,19 +65,27 @@ phaser::~phaser()
 
 void phaser::process(const dsp_input& in, dsp_output& out)
 {
+    /*
+     * Modulate allpass fc (1 - 3 octaves):
+     * - map LFO sine range from [-1,1] to [a, b] using equation: y = 0.5 * (b - a) * (sin(x) + 1) + a
+     * - a is always 1
+     * - b is depth mapped from [0, 1] to [2, 8]
+     * Coefficient is calculated only at control points and interpolated in between.
+     */
+    const float depth = 0.5f * ((2.0f + this->attr.ctrl.depth * 6.0f) - 1.0f);
+    this->apf_coeff_mod.process(this->apf_coeff.data(), in.size(),
+    [this, depth](uint32_t samples)
+    {
+        const float mod = depth * (this->lfo.advance(samples) + 1.0f) + 1.0f;
+        return this->calc_apf_coeff(apf_fc * mod, config::sampling_frequency_hz);
+    }
+    );
+
+    auto coeff_it = this->apf_coeff.begin();
     std::transform(in.begin(), in.end(), out.begin(),
-    [this](auto input)
+    [this, &coeff_it](auto input)
     {
-        /*
-         * Modulate allpass fc (1 - 3 octaves):
-         * - map LFO sine range from [-1,1] to [a, b] using equation: y = 0.5 * (b - a) * (sin(x) + 1) + a
-         * - a is always 1
-         * - b is depth mapped from [0, 1] to [2, 8]
-         */
-        constexpr float apf_fc = 141;
-        const float depth = 0.5f * ((2.0f + this->attr.ctrl.depth * 6.0f) - 1.0f);
-        const float mod = depth * (this->lfo.generate() + 1.0f) + 1.0f;
-        const float apf_coeff = this->calc_apf_coeff(apf_fc * mod, config::sampling_frequency_hz);
+        const float apf_coeff = *coeff_it++;
 
         /* Cascade of four all-pass filters (with feeedback) */
         float output = input;
@@ -94,6 +114,12 @@ const effect_specific_attr phaser::get_specific_attributes(void) const
     return attributes;
 }
 
+uint32_t phaser::tail_length(void) const
+{
+    /* Short all-pass chain with feedback */
+    return config::sampling_frequency_hz / 100;
+}
+
 void phaser::set_rate(float rate)
 {
     rate = utils::lin_to_log(rate);
@@ -10,6 +10,8 @@
 
 #include "app/model/effect_interface.hpp"
 
+#include <array>
+
 #include <libs/audio_dsp.hpp>
 
 namespace mfx
@@ -23,6 +25,7 @@ public:
 
     void process(const dsp_input &in, dsp_output &out) override;
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
 
     void set_rate(float rate);
     void set_depth(float depth);
@@ -31,7 +34,12 @@ private:
     float calc_apf_coeff(float fc, float fs);
 
     float apf_feedback;
-    libs::adsp::oscillator lfo;
+    libs::adsp::wavetable_oscillator lfo;
+
+    /* Modulation targets (evaluated at control rate) */
+    libs::adsp::control_rate_modulator<config::control_rate_period> apf_coeff_mod;
+    std::array<float, config::dsp_max_buffer_size> apf_coeff;
+
     libs::adsp::basic_iir<libs::adsp::basic_iir_type::allpass> apf1;
     libs::adsp::basic_iir<libs::adsp::basic_iir_type::allpass> apf2;
     libs::adsp::basic_iir<libs::adsp::basic_iir_type::allpass> apf3;
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 
 using namespace mfx;
 
@@ -81,6 +82,104 @@ std::array<float, static_cast<uint32_t>(del4_len * config::sampling_frequency_hz
 //-----------------------------------------------------------------------------
 /* private */
 
+void reverb::process_tank(const float *in, uint32_t n)
+{
+    /* J. Dattorro's reverb implementation (all delays in the tank are longer than block, so it can be processed block-wise) */
+    const float decay = this->attr.ctrl.decay;
+    const bool modulated = this->attr.ctrl.mode == reverb_attr::controls::mode_type::mod;
+
+    /* Input diffusers */
+    this->pdel.read(this->diffused.data(), n);
+    this->pdel.write(in, n);
+    this->lpf1.process(this->diffused.data(), this->diffused.data(), n);
+    this->apf1.process(this->diffused.data(), this->diffused.data(), n);
+    this->apf2.process(this->diffused.data(), this->diffused.data(), n);
+    this->apf3.process(this->diffused.data(), this->diffused.data(), n);
+    this->apf4.process(this->diffused.data(), this->diffused.data(), n);
+
+    /* 8-figure "tank" */
+
+    /* right loop */
+    this->del4.read(this->tap.data(), n);
+    arm_scale_f32(this->tap.data(), decay, this->tap.data(), n);
+    arm_add_f32(this->diffused.data(), this->tap.data(), this->tap.data(), n);
+    if (modulated)
+    {
+        this->mapf1_delay_mod.process(this->mod.data(), n,
+        [this](uint32_t samples)
+        {
+            return (mapf1_del_len + this->lfo1.advance(samples) * mapf_excursion) * config::sampling_frequency_hz;
+        }
+        );
+        this->mapf1.process<false, true, 0>(this->tap.data(), this->tap.data(), this->mod.data(), n);
+    }
+    else
+    {
+        this->mapf1.process<false, true, 0>(this->tap.data(), this->tap.data(), n);
+    }
+    this->del1.read(this->right.data(), n);
+    this->del1.write(this->tap.data(), n);
+    this->lpf2.process(this->right.data(), this->right.data(), n);
+    arm_scale_f32(this->right.data(), decay, this->right.data(), n);
+    this->apf5.process(this->right.data(), this->right.data(), n);
+
+    /* left loop */
+    this->del2.read(this->tap.data(), n);
+    arm_scale_f32(this->tap.data(), decay, this->tap.data(), n);
+    arm_add_f32(this->diffused.data(), this->tap.data(), this->tap.data(), n);
+    if (modulated)
+    {
+        this->mapf2_delay_mod.process(this->mod.data(), n,
+        [this](uint32_t samples)
+        {
+            return (mapf2_del_len + this->lfo2.advance(samples) * mapf_excursion) * config::sampling_frequency_hz;
+        }
+        );
+        this->mapf2.process<false, true, 0>(this->tap.data(), this->tap.data(), this->mod.data(), n);
+    }
+    else
+    {
+        this->mapf2.process<false, true, 0>(this->tap.data(), this->tap.data(), n);
+    }
+    this->del3.read(this->left.data(), n);
+    this->del3.write(this->tap.data(), n);
+    this->lpf3.process(this->left.data(), this->left.data(), n);
+    arm_scale_f32(this->left.data(), decay, this->left.data(), n);
+    this->apf6.process(this->left.data(), this->left.data(), n);
+
+    this->del2.write(this->right.data(), n);
+    this->del4.write(this->left.data(), n);
+
+    /* Output taps (read after the whole block is written, hence additional delay of n - 1 samples) */
+    const auto add_tap = [this, n](float *acc, auto &line, uint32_t d)
+    {
+        line.read(this->tap.data(), n, d + n - 1);
+        arm_add_f32(acc, this->tap.data(), acc, n);
+    };
+
+    const auto sub_tap = [this, n](float *acc, auto &line, uint32_t d)
+    {
+        line.read(this->tap.data(), n, d + n - 1);
+        arm_sub_f32(acc, this->tap.data(), acc, n);
+    };
+
+    this->del1.read(this->left.data(), n, left_out_del1_tap1 + n - 1);
+    add_tap(this->left.data(), this->del1, left_out_del1_tap2);
+    sub_tap(this->left.data(), this->apf5, left_out_apf5_tap);
+    add_tap(this->left.data(), this->del2, left_out_del2_tap);
+    sub_tap(this->left.data(), this->del3, left_out_del3_tap);
+    sub_tap(this->left.data(), this->apf6, left_out_apf6_tap);
+    sub_tap(this->left.data(), this->del4, left_out_del4_tap);
+
+    this->del3.read(this->right.data(), n, right_out_del3_tap1 + n - 1);
+    add_tap(this->right.data(), this->del3, right_out_del3_tap2);
+    sub_tap(this->right.data(), this->apf6, right_out_apf6_tap);
+    add_tap(this->right.data(), this->del4, right_out_del4_tap);
+    sub_tap(this->right.data(), this->del1, right_out_del1_tap);
+    sub_tap(this->right.data(), this->apf5, right_out_apf5_tap);
+    sub_tap(this->right.data(), this->del2, right_out_del2_tap);
+}
+
 //-----------------------------------------------------------------------------
 /* public */
 
@@ -99,8 +198,10 @@ apf5 { decay_diffusion_2, -decay_diffusion_2, 1, apf5_del_len, config::sampling_
 apf6 { decay_diffusion_2, -decay_diffusion_2, 1, apf6_del_len, config::sampling_frequency_hz },
 mapf1 { -decay_diffusion_1, decay_diffusion_1, 1, mapf1_del_len + mapf_excursion, config::sampling_frequency_hz },
 mapf2 { -decay_diffusion_1, decay_diffusion_1, 1, mapf2_del_len + mapf_excursion, config::sampling_frequency_hz },
-lfo1 { libs::adsp::oscillator::shape::sine, mapf_rate, config::sampling_frequency_hz },
-lfo2 { libs::adsp::oscillator::shape::cosine, 0.95f * mapf_rate, config::sampling_frequency_hz },
+lfo1 { libs::adsp::wavetable_oscillator::shape::sine, mapf_rate, config::sampling_frequency_hz },
+lfo2 { libs::adsp::wavetable_oscillator::shape::cosine, 0.95f * mapf_rate, config::sampling_frequency_hz },
+mapf1_delay_mod { mapf1_del_len * config::sampling_frequency_hz },
+mapf2_delay_mod { mapf2_del_len * config::sampling_frequency_hz },
 mix { 0.35f },
 attr {}
 {
@@ -123,55 +224,35 @@ reverb::~reverb()
 
 void reverb::process(const dsp_input& in, dsp_output& out)
 {
-    /* J. Dattorro's reverb implementation */
-    std::transform(in.begin(), in.end(), out.begin(),
-    [this](auto input)
+    const uint32_t n = in.size();
+    this->process_tank(in.data(), n);
+
+    for (uint32_t i = 0; i < n; i++)
+        out[i] = this->mix * lr_out_scale * 0.5f * (this->left[i] + this->right[i]) + (1 - this->mix) * in[i];
+}
+
+void reverb::process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r)
+{
+    /* Tank has single input, so it is fed with mid signal (outputs of tank are already decorrelated) */
+    const uint32_t n = in_l.size();
+    const float *in = in_l.data();
+    if (&in_l != &in_r)
     {
-        /* Input diffusers */
-        float sample = this->pdel.get();
-        this->pdel.put(input);
-        sample = this->lpf1.process(sample);
-        sample = this->apf4.process(this->apf3.process(this->apf2.process(this->apf1.process(sample))));
-
-        /* 8-figure "tank" */
-
-        /* right loop */
-        if (this->attr.ctrl.mode == reverb_attr::controls::mode_type::mod)
-            this->mapf1.set_delay(mapf1_del_len + this->lfo1.generate() * mapf_excursion);
-        float rl_sample = this->del1.get();
-        this->del1.put(this->mapf1.process<false, true, 0>(sample + this->del4.get() * this->attr.ctrl.decay));
-        rl_sample = this->apf5.process(this->lpf2.process(rl_sample) * this->attr.ctrl.decay);
-
-        /* left loop */
-        if (this->attr.ctrl.mode == reverb_attr::controls::mode_type::mod)
-            this->mapf2.set_delay(mapf2_del_len + this->lfo2.generate() * mapf_excursion);
-        float ll_sample = this->del3.get();
-        this->del3.put(this->mapf2.process<false, true, 0>(sample + this->del2.get() * this->attr.ctrl.decay));
-        ll_sample = this->apf6.process(this->lpf3.process(ll_sample) * this->attr.ctrl.decay);
-
-        this->del2.put(rl_sample);
-        this->del4.put(ll_sample);
-
-        /* Output taps */
-        const float left_out = this->del1.at(left_out_del1_tap1) +
-                               this->del1.at(left_out_del1_tap2) -
-                               this->apf5.at(left_out_apf5_tap) +
-                               this->del2.at(left_out_del2_tap) -
-                               this->del3.at(left_out_del3_tap) -
-                               this->apf6.at(left_out_apf6_tap) -
-                               this->del4.at(left_out_del4_tap);
-
-        const float right_out = this->del3.at(right_out_del3_tap1) +
-                                this->del3.at(right_out_del3_tap2) -
-                                this->apf6.at(right_out_apf6_tap) +
-                                this->del4.at(right_out_del4_tap) -
-                                this->del1.at(right_out_del1_tap) -
-                                this->apf5.at(right_out_apf5_tap) -
-                                this->del2.at(right_out_del2_tap);
-
-        return this->mix * lr_out_scale * 0.5f * (left_out + right_out) + (1 - this->mix) * input;
+        for (uint32_t i = 0; i < n; i++)
+            this->input[i] = 0.5f * (in_l[i] + in_r[i]);
+
+        in = this->input.data();
+    }
+
+    this->process_tank(in, n);
+
+    /* Equal power of wet signal as in mono output (sum of uncorrelated channels) */
+    const float wet = this->mix * lr_out_scale * M_SQRT1_2;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out_l[i] = wet * this->left[i] + (1 - this->mix) * in_l[i];
+        out_r[i] = wet * this->right[i] + (1 - this->mix) * in_r[i];
     }
-    );
 }
 
 const effect_specific_attr reverb::get_specific_attributes(void) const
@@ -179,6 +260,19 @@ const effect_specific_attr reverb::get_specific_attributes(void) const
     return this->attr;
 }
 
+uint32_t reverb::tail_length(void) const
+{
+    /* Tank recirculates with gain of decay^2 per loop, count loops until -120dB */
+    constexpr float input_len = pdel_len + apf1_del_len + apf2_del_len + apf3_del_len + apf4_del_len;
+    constexpr float loop_len = del1_len + del2_len + del3_len + del4_len + apf5_del_len + apf6_del_len +
+                               mapf1_del_len + mapf2_del_len + 2 * mapf_excursion;
+
+    const float decay = this->attr.ctrl.decay;
+    const float loops = (decay > 0) ? std::ceil(std::log(1e-6f) / (2 * std::log(decay))) : 1;
+
+    return (input_len + loops * loop_len) * config::sampling_frequency_hz;
+}
+
 void reverb::set_bandwidth(float bandwidth)
 {
     bandwidth = std::clamp(bandwidth, 0.001f, 1.0f);
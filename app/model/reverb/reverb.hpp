@@ -10,6 +10,8 @@
 
 #include "app/model/effect_interface.hpp"
 
+#include <array>
+
 #include <libs/audio_dsp.hpp>
 
 namespace mfx
@@ -22,7 +24,10 @@ public:
     virtual ~reverb();
 
     void process(const dsp_input &in, dsp_output &out) override;
+    void process_stereo(const dsp_input &in_l, const dsp_input &in_r, dsp_output &out_l, dsp_output &out_r) override;
+    bool is_stereo(void) const override { return true; };
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
 
     void set_bandwidth(float bw);
     void set_damping(float d);
@@ -30,14 +35,22 @@ public:
     void set_mode(reverb_attr::controls::mode_type mode);
 
 private:
+    void process_tank(const float *in, uint32_t n);
+
     libs::adsp::delay_line pdel, del1, del2, del3, del4;
     libs::adsp::basic_iir<libs::adsp::basic_iir_type::lowpass> lpf1, lpf2, lpf3;
     libs::adsp::unicomb apf1, apf2, apf3, apf4, apf5, apf6;
     libs::adsp::unicomb mapf1, mapf2;
-    libs::adsp::oscillator lfo1, lfo2;
+    libs::adsp::wavetable_oscillator lfo1, lfo2;
+
+    /* Modulation targets (evaluated at control rate) */
+    libs::adsp::control_rate_modulator<config::control_rate_period> mapf1_delay_mod, mapf2_delay_mod;
 
     float mix;
 
+    /* Intermediate buffers for block processing */
+    std::array<float, config::dsp_max_buffer_size> input, diffused, right, left, tap, mod;
+
     reverb_attr attr {0};
 };
 
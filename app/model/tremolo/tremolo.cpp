@@ -27,7 +27,7 @@ namespace
 /* public */
 
 tremolo::tremolo() : effect { effect_id::tremolo },
-lfo { libs::adsp::oscillator::shape::sine, tremolo_attr::default_ctrl.rate, config::sampling_frequency_hz },
+lfo { libs::adsp::wavetable_oscillator::shape::sine, tremolo_attr::default_ctrl.rate, config::sampling_frequency_hz },
 attr {}
 {
     const auto& def = tremolo_attr::default_ctrl;
@@ -44,16 +44,16 @@ tremolo::~tremolo()
 
 void tremolo::process(const dsp_input& in, dsp_output& out)
 {
-    std::transform(in.begin(), in.end(), out.begin(),
-    [this](auto input)
-    {
-        /* Modulate output signal: y[n] = x[n] * ((1 - d) + d * m[n]) */
-        float mod = this->lfo.generate();
-        if (this->attr.ctrl.shape == tremolo_attr::controls::shape_type::square)
-            mod = this->lpf.process(mod);
-        return input * ((1.0f - this->attr.ctrl.depth) + this->attr.ctrl.depth * mod);
-    }
-    );
+    /* Modulating signal is generated directly in output buffer */
+    const uint32_t n = in.size();
+    this->lfo.generate(out.data(), n);
+    if (this->attr.ctrl.shape == tremolo_attr::controls::shape_type::square)
+        this->lpf.process(out.data(), out.data(), n);
+
+    /* Modulate output signal: y[n] = x[n] * ((1 - d) + d * m[n]) */
+    arm_scale_f32(out.data(), this->attr.ctrl.depth, out.data(), n);
+    arm_offset_f32(out.data(), 1.0f - this->attr.ctrl.depth, out.data(), n);
+    arm_mult_f32(const_cast<float*>(in.data()), out.data(), out.data(), n);
 }
 
 const effect_specific_attr tremolo::get_specific_attributes(void) const
@@ -93,10 +93,10 @@ void tremolo::set_shape(tremolo_attr::controls::shape_type shape)
     switch (this->attr.ctrl.shape)
     {
     case tremolo_attr::controls::shape_type::sine:
-        this->lfo.set_shape(libs::adsp::oscillator::shape::sine);
+        this->lfo.set_shape(libs::adsp::wavetable_oscillator::shape::sine);
         break;
     case tremolo_attr::controls::shape_type::square:
-        this->lfo.set_shape(libs::adsp::oscillator::shape::square);
+        this->lfo.set_shape(libs::adsp::wavetable_oscillator::shape::square);
         break;
     default:
         break;
@@ -28,7 +28,7 @@ public:
     void set_rate(float rate);
     void set_shape(tremolo_attr::controls::shape_type shape);
 private:
-    libs::adsp::oscillator lfo;
+    libs::adsp::wavetable_oscillator lfo;
     libs::adsp::basic_iir<libs::adsp::basic_iir_type::lowpass> lpf;
 
     tremolo_attr attr {0};
@@ -7,6 +7,8 @@
 
 #include "tuner.hpp"
 
+#include <libs/fast_math.hpp>
+
 using namespace mfx;
 
 //-----------------------------------------------------------------------------
@@ -23,6 +25,25 @@ constexpr float hpf_cutoff = 50.0f;     // 50 Hz
 constexpr float envf_attack = 0.02f;    // 20 ms
 constexpr float envf_release = 0.2f;    // 200 ms
 
+/* Use fast approximations of log2() & 2^x in note calculation (max error below 0.01 cent) */
+constexpr bool fast_math {false};
+
+float note_log2(float x)
+{
+    if constexpr (fast_math)
+        return libs::adsp::fastmath::log2(x);
+    else
+        return std::log2(x);
+}
+
+float note_exp2(float x)
+{
+    if constexpr (fast_math)
+        return libs::adsp::fastmath::exp2(x);
+    else
+        return std::exp2(x);
+}
+
 }
 
 //-----------------------------------------------------------------------------
@@ -63,8 +84,19 @@ void tuner::process(const dsp_input& in, dsp_output& out)
     else
         arm_copy_f32((float*)in.data(), out.data(), out.size());
 
+    /* 2. - 4. Analyze signal in fixed size blocks */
+    this->adapter.process(in.data(), in.size(),
+    [this](const auto &blk_in)
+    {
+        this->analyze(blk_in[0]);
+    }
+    );
+}
+
+void tuner::analyze(const float *in)
+{
     /* 2. Decimate signal for further processing */
-    this->decimator.process(in.data(), this->decim_input.data());
+    this->decimator.process(in, this->decim_input.data());
 
     /* 3. Apply high-pass filter & detect envelope */
     std::transform(this->decim_input.begin(), this->decim_input.end(), this->decim_input.begin(),
@@ -103,11 +135,11 @@ void tuner::process(const dsp_input& in, dsp_output& out)
                 'a', 'A', 'b', 'b', 'C', 'd', 'D', 'e', 'f', 'F', 'g', 'G'
             };
 
-            int note_number = std::round(12 * std::log2(this->attr.out.pitch / this->attr.ctrl.a4_tuning) + 49);
+            int note_number = std::round(12 * note_log2(this->attr.out.pitch / this->attr.ctrl.a4_tuning) + 49);
             int note_idx = (note_number - 1) % 12;
             int octave = (note_number + 8) / 12;
-            float nearest_freq = this->attr.ctrl.a4_tuning * std::pow(2.0f, (note_number - 49) / 12.0f);
-            float cents_err = 1200.0f * std::log2(this->attr.out.pitch / nearest_freq);
+            float nearest_freq = this->attr.ctrl.a4_tuning * note_exp2((note_number - 49) / 12.0f);
+            float cents_err = 1200.0f * note_log2(this->attr.out.pitch / nearest_freq);
 
             /* Fill result */
             this->attr.out.note = notes[std::clamp(note_idx, 0, 11)];
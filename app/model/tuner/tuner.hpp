@@ -29,6 +29,10 @@ public:
 
     constexpr static unsigned decim_factor {4};
 private:
+    void analyze(const float *in);
+
+    /* Pitch is analyzed in blocks of fixed size (output is not delayed) */
+    libs::adsp::fixed_block_adapter<config::dsp_buffer_size> adapter;
     libs::adsp::decimator<decim_factor, config::dsp_buffer_size> decimator;
     libs::adsp::basic_iir<libs::adsp::basic_iir_type::highpass> hpf;
     libs::adsp::envelope_follower envf;
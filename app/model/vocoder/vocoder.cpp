@@ -33,46 +33,60 @@ public:
     {
         for (unsigned i = 0; i < bands; i++)
         {
-            this->car_bpf[i].set_coeffs(this->bandpass_coeffs[i]);
-            this->car_lpf[i].set_coeffs(this->lowpass_coeffs);
-            this->mod_bpf[i].set_coeffs(this->bandpass_coeffs[i]);
-            this->mod_lpf[i].set_coeffs(this->lowpass_coeffs);
+            this->car_bpf.set_coeffs(i, this->bandpass_coeffs[i]);
+            this->car_lpf.set_coeffs(i, this->lowpass_coeffs);
+            this->mod_bpf.set_coeffs(i, this->bandpass_coeffs[i]);
+            this->mod_lpf.set_coeffs(i, this->lowpass_coeffs);
         }
     }
 
     void process(const dsp_input &car, const dsp_input &mod, dsp_output &out)
     {
-        arm_fill_f32(0, out.data(), out.size());
+        const bool hold = this->attr.ctrl.hold;
+        const float epsi = (1 - this->attr.ctrl.clarity);
 
-        for (unsigned band = 0; band < this->bands; band++)
+        std::array<float, bands> car_bp, car_env, mod_env, mod_sum {};
+
+        if (hold)
+            mod_env = this->mod_hold;
+
+        /* All bands are processed per sample */
+        for (unsigned i = 0; i < out.size(); i++)
         {
             /* Carrier envelope */
-            this->car_bpf[band].process(car.data(), this->car_bp.data(), this->car_bp.size());
-            arm_mult_f32(this->car_bp.data(), this->car_bp.data(), this->car_env.data(), this->car_env.size());
-            this->car_lpf[band].process(this->car_env.data(), this->car_env.data(), this->car_env.size());
+            this->car_bpf.process(car[i], car_bp.data());
+            for (unsigned band = 0; band < bands; band++)
+                car_env[band] = car_bp[band] * car_bp[band];
+            this->car_lpf.process(car_env.data(), car_env.data());
 
             /* Modulator envelope */
-            if (!this->attr.ctrl.hold)
+            if (!hold)
             {
-                this->mod_bpf[band].process(mod.data(), this->mod_env.data(), this->mod_env.size());
-                arm_mult_f32(this->mod_env.data(), this->mod_env.data(), this->mod_env.data(), this->mod_env.size());
-                this->mod_lpf[band].process(this->mod_env.data(), this->mod_env.data(), this->mod_env.size());
+                this->mod_bpf.process(mod[i], mod_env.data());
+                for (unsigned band = 0; band < bands; band++)
+                    mod_env[band] *= mod_env[band];
+                this->mod_lpf.process(mod_env.data(), mod_env.data());
 
-                /* Save modulator envelope for 'hold' feature */
-                arm_mean_f32(this->mod_env.data(), this->mod_env.size(), &this->mod_hold[band]);
+                for (unsigned band = 0; band < bands; band++)
+                    mod_sum[band] += mod_env[band];
             }
 
             /* Cross-synthesis */
-            const float epsi = (1 - this->attr.ctrl.clarity);
-            for (unsigned i = 0; i < out.size(); i++)
+            float output = 0;
+            for (unsigned band = 0; band < bands; band++)
             {
-                if (this->attr.ctrl.hold)
-                    this->mod_env[i] = this->mod_hold[band];
-
                 float env;
-                arm_sqrt_f32(this->mod_env[i] / (this->car_env[i] + epsi), &env);
-                out[i] += this->car_bp[i] * env;
+                arm_sqrt_f32(mod_env[band] / (car_env[band] + epsi), &env);
+                output += car_bp[band] * env;
             }
+            out[i] = output;
+        }
+
+        /* Save modulator envelope for 'hold' feature */
+        if (!hold)
+        {
+            for (unsigned band = 0; band < bands; band++)
+                this->mod_hold[band] = mod_sum[band] / out.size();
         }
     }
 
@@ -172,14 +186,9 @@ private:
         bandpass_12_coeffs,
     };
 
-    std::array<libs::adsp::iir_biquad<2>, bands> car_bpf;
-    std::array<libs::adsp::iir_biquad<1>, bands> car_lpf;
-    std::array<float, mfx::config::dsp_buffer_size> car_env, car_bp;
-
-    std::array<libs::adsp::iir_biquad<2>, bands> mod_bpf;
-    std::array<libs::adsp::iir_biquad<1>, bands> mod_lpf;
-    std::array<float, mfx::config::dsp_buffer_size> mod_env;
-    std::array<float, bands> mod_hold;
+    libs::adsp::iir_filterbank<bands, 2> car_bpf, mod_bpf;
+    libs::adsp::iir_filterbank<bands, 1> car_lpf, mod_lpf;
+    std::array<float, bands> mod_hold {};
 
     vocoder_attr &attr;
 };
@@ -190,18 +199,36 @@ class vocoder::modern_vocoder
 public:
     modern_vocoder(vocoder_attr &attributes) : attr {attributes}
     {
-        arm_rfft_fast_init_f32(&this->fft, this->window_size);
-        arm_rfft_fast_init_f32(&this->fft_filter, this->window_size / 2);
+        this->init_window(max_window_size);
+    }
 
-        arm_fill_f32(0, this->car_input.data(), this->car_input.size());
-        arm_fill_f32(0, this->mod_input.data(), this->mod_input.size());
-        arm_fill_f32(0, this->output.data(), this->output.size());
+    void set_window_size(unsigned size)
+    {
+        if (this->window_size == size)
+            return;
+
+        this->init_window(size);
+
+        /* Bandpass filter depends on window size (bands are set later, when mode is being changed) */
+        if (this->attr.ctrl.mode == vocoder_attr::controls::mode_type::modern && this->attr.ctrl.bands != 0)
+            this->change_bands(this->attr.ctrl.bands);
     }
 
     void process(const dsp_input &car, const dsp_input &mod, dsp_output &out)
+    {
+        /* STFT hop is fixed, other block sizes are buffered */
+        this->adapter.process({car.data(), mod.data()}, out.data(), out.size(),
+        [this](const auto &blk_in, float *blk_out)
+        {
+            this->process_block(blk_in[0], blk_in[1], blk_out);
+        }
+        );
+    }
+
+    void process_block(const float *car, const float *mod, float *out)
     {
         constexpr unsigned block_size = config::dsp_buffer_size;
-        constexpr unsigned move_size = this->window_size - block_size;
+        const unsigned move_size = this->window_size - block_size;
 
         float *cenv_in = this->car_env.data();
         float *cenv_out = this->car_env.data() + this->window_size;
@@ -210,17 +237,17 @@ public:
 
         /* Sliding window of input signal chunks */
         arm_copy_f32(this->car_input.data() + block_size, this->car_input.data(), move_size);
-        arm_copy_f32(const_cast<float*>(car.data()), this->car_input.data() + move_size, block_size);
+        arm_copy_f32(const_cast<float*>(car), this->car_input.data() + move_size, block_size);
 
         if (!this->attr.ctrl.hold)
         {
             arm_copy_f32(this->mod_input.data() + block_size, this->mod_input.data(), move_size);
-            arm_copy_f32(const_cast<float*>(mod.data()), this->mod_input.data() + move_size, block_size);
+            arm_copy_f32(const_cast<float*>(mod), this->mod_input.data() + move_size, block_size);
         }
 
         /* Windowing */
-        arm_mult_f32(this->car_input.data(), const_cast<float*>(this->window_hann.data()), cenv_in, this->window_size);
-        arm_mult_f32(this->mod_input.data(), const_cast<float*>(this->window_hann.data()), menv_in, this->window_size);
+        arm_mult_f32(this->car_input.data(), this->window.data(), cenv_in, this->window_size);
+        arm_mult_f32(this->mod_input.data(), this->window.data(), menv_in, this->window_size);
 
         /* STFT of sliding window */
         arm_rfft_fast_f32(&this->fft, cenv_in, cenv_out, 0);
@@ -279,7 +306,7 @@ public:
         arm_add_f32(this->output.data(), cenv_in, this->output.data(), this->window_size);
 
         /* Copy result to output */
-        arm_copy_f32(this->output.data(), out.data(), block_size);
+        arm_copy_f32(this->output.data(), out, block_size);
     }
 
     void change_bands(unsigned bands)
@@ -313,8 +340,27 @@ public:
 
     constexpr static unsigned bands_variants {6};
 
+    constexpr static unsigned max_window_size {1024};
+
 private:
-    constexpr static unsigned window_size {1024};
+    void init_window(unsigned size)
+    {
+        this->window_size = size;
+
+        arm_rfft_fast_init_f32(&this->fft, this->window_size);
+        arm_rfft_fast_init_f32(&this->fft_filter, this->window_size / 2);
+
+        /* Decimated window keeps hop size, so it is rescaled for lower overlap */
+        const unsigned step = max_window_size / this->window_size;
+        for (unsigned i = 0; i < this->window_size; i++)
+            this->window[i] = this->window_hann[i * step] * step;
+
+        arm_fill_f32(0, this->car_input.data(), this->car_input.size());
+        arm_fill_f32(0, this->mod_input.data(), this->mod_input.size());
+        arm_fill_f32(0, this->output.data(), this->output.size());
+    }
+
+    unsigned window_size;
 
     /* Hanning window for 7/8 overlap */
         constexpr static std::array<float, 1024> window_hann
@@ -664,8 +710,11 @@ private:
     };
 
     arm_rfft_fast_instance_f32 fft, fft_filter;
-    std::array<float, 2 * window_size> car_env, mod_env;
-    std::array<float, window_size> car_input, car_stfft, mod_input, output, filter;
+    std::array<float, max_window_size> window;
+    std::array<float, 2 * max_window_size> car_env, mod_env;
+    std::array<float, max_window_size> car_input, car_stfft, mod_input, output, filter;
+
+    libs::adsp::fixed_block_adapter<config::dsp_buffer_size, 2> adapter;
 
     vocoder_attr &attr;
 };
@@ -690,20 +739,45 @@ vocoder::~vocoder()
 
 }
 
+void vocoder::set_quality(effect_quality level)
+{
+    /* Low: 512 samples STFT window (4x overlap), medium & high: 1024 samples (8x overlap) */
+    this->modern->set_window_size(level == effect_quality::low ? this->modern->max_window_size / 2 : this->modern->max_window_size);
+    this->quality = level;
+}
+
+uint32_t vocoder::cost_estimate(effect_quality level) const
+{
+    /* Vintage vocoder (IIR filterbank) has single level */
+    if (this->attr.ctrl.mode == vocoder_attr::controls::mode_type::vintage)
+        return 0;
+
+    constexpr std::array<uint32_t, static_cast<uint8_t>(effect_quality::_count)> cost {9, 20, 20};
+    return cost.at(static_cast<uint8_t>(level));
+}
+
+bool vocoder::supports_block_size(size_t size) const
+{
+    /* Modern vocoder uses fixed STFT hop */
+    return this->attr.ctrl.mode == vocoder_attr::controls::mode_type::vintage || size % config::dsp_buffer_size == 0;
+}
+
 void vocoder::process(const dsp_input& in, dsp_output& out)
 {
     if (this->aux_in == nullptr)
         return;
 
-    this->hp.process(this->aux_in->data(), const_cast<float*>(this->aux_in->data()), this->aux_in->size());
+    /* Aux input is shared (e.g. by both chains while they are crossfaded), so it's filtered into own buffer */
+    this->modulator.resize(this->aux_in->size());
+    this->hp.process(this->aux_in->data(), this->modulator.data(), this->aux_in->size());
 
     if (this->attr.ctrl.mode == vocoder_attr::controls::mode_type::vintage)
     {
-        this->vintage->process(in, *this->aux_in, out);
+        this->vintage->process(in, this->modulator, out);
     }
     else
     {
-        this->modern->process(in, *this->aux_in, out);
+        this->modern->process(in, this->modulator, out);
     }
 }
 
@@ -715,6 +789,15 @@ const effect_specific_attr vocoder::get_specific_attributes(void) const
     return attributes;
 }
 
+uint32_t vocoder::tail_length(void) const
+{
+    /* Carrier is being held in STFT window (modern) or in filterbank & envelope followers (vintage) */
+    if (this->attr.ctrl.mode == vocoder_attr::controls::mode_type::vintage)
+        return config::sampling_frequency_hz / 20;
+
+    return this->modern->max_window_size + config::dsp_buffer_size;
+}
+
 void vocoder::set_mode(vocoder_attr::controls::mode_type mode)
 {
     if (this->attr.ctrl.mode == mode)
@@ -26,6 +26,10 @@ public:
 
     void process(const dsp_input &in, dsp_output &out) override;
     const effect_specific_attr get_specific_attributes(void) const override;
+    uint32_t tail_length(void) const override;
+    bool supports_block_size(size_t size) const override;
+    void set_quality(effect_quality level) override;
+    uint32_t cost_estimate(effect_quality level) const override;
 
     void set_mode(vocoder_attr::controls::mode_type mode);
     void set_clarity(float clarity);
@@ -35,6 +39,7 @@ public:
 
 private:
     libs::adsp::iir_highpass hp;
+    dsp_buffer modulator;
 
     class vintage_vocoder;
     class modern_vocoder;
@@ -104,6 +104,9 @@ public:
     bool get_usb_direct_mon_enabled(void) { return this->settings[k_usb_direct_mon_enabled].get<bool>(); };
     void set_usb_direct_mon_enabled(bool value) { set(k_usb_direct_mon_enabled, value); }
 
+    uint16_t get_dsp_block_size(void) { return this->settings[k_dsp_block_size].get<uint16_t>(); };
+    void set_dsp_block_size(uint16_t value) { set(k_dsp_block_size, value); }
+
 private:
     void set_defaults(void)
     {
@@ -117,6 +120,7 @@ private:
         this->settings[k_mic_routed_to_aux] = true;        // Route microphone signal to AUX, values: true/false
         this->settings[k_usb_audio_if_enabled] = false;    // USB audio interface enabled, values: true/false
         this->settings[k_usb_direct_mon_enabled] = false;  // USB direct monitoring enabled, values: true/false
+        this->settings[k_dsp_block_size] = 128;            // DSP block size in samples, values: 32, 64, 128, 256
     }
 
     template<typename T>
@@ -143,6 +147,7 @@ private:
     static constexpr const char *k_mic_routed_to_aux = "mic_routed_to_aux";
     static constexpr const char *k_usb_audio_if_enabled = "usb_audio_if_enabled";
     static constexpr const char *k_usb_direct_mon_enabled = "usb_direct_mon_enabled";
+    static constexpr const char *k_dsp_block_size = "dsp_block_size";
 };
 
 #endif /* SETTINGS_HPP_ */
@@ -0,0 +1,226 @@
+/*
+ * cmsis_host.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+/*
+ * Host (reference) implementations of CMSIS DSP functions used by libs/audio_dsp.hpp. Prebuilt CMSIS DSP library
+ * is for Cortex-M7 only, so unit tests link against these. Semantics (incl. data layouts) follow CMSIS DSP.
+ */
+
+#include <cmsis/dsp/arm_math.h>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+/* private */
+
+namespace
+{
+
+/* Iterative radix-2 complex FFT (in double precision), unscaled in both directions */
+void fft(std::vector<std::complex<double>> &a, bool inverse)
+{
+    const size_t n = a.size();
+
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const double angle = 2 * M_PI / len * (inverse ? 1 : -1);
+        const std::complex<double> w_len {std::cos(angle), std::sin(angle)};
+
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> w {1};
+            for (size_t k = 0; k < len / 2; k++)
+            {
+                const auto u = a[i + k];
+                const auto v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= w_len;
+            }
+        }
+    }
+}
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t fftLen)
+{
+    if (fftLen < 32 || fftLen > 4096 || (fftLen & (fftLen - 1)))
+        return ARM_MATH_ARGUMENT_ERROR;
+
+    S->fftLenRFFT = fftLen;
+    return ARM_MATH_SUCCESS;
+}
+
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag)
+{
+    const uint32_t n = S->fftLenRFFT;
+    std::vector<std::complex<double>> a(n);
+
+    if (ifftFlag == 0)
+    {
+        for (uint32_t i = 0; i < n; i++)
+            a[i] = p[i];
+
+        fft(a, false);
+
+        /* Packed spectrum: real DC & Nyquist bins first, then bins 1 ... n/2 - 1 */
+        pOut[0] = a[0].real();
+        pOut[1] = a[n / 2].real();
+        for (uint32_t k = 1; k < n / 2; k++)
+        {
+            pOut[2 * k + 0] = a[k].real();
+            pOut[2 * k + 1] = a[k].imag();
+        }
+    }
+    else
+    {
+        a[0] = p[0];
+        a[n / 2] = p[1];
+        for (uint32_t k = 1; k < n / 2; k++)
+        {
+            a[k] = {p[2 * k + 0], p[2 * k + 1]};
+            a[n - k] = std::conj(a[k]);
+        }
+
+        fft(a, true);
+
+        for (uint32_t i = 0; i < n; i++)
+            pOut[i] = a[i].real() / n;
+    }
+}
+
+void arm_copy_f32(float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    std::copy(pSrc, pSrc + blockSize, pDst);
+}
+
+void arm_fill_f32(float32_t value, float32_t *pDst, uint32_t blockSize)
+{
+    std::fill(pDst, pDst + blockSize, value);
+}
+
+void arm_add_f32(float32_t *pSrcA, float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+        pDst[i] = pSrcA[i] + pSrcB[i];
+}
+
+void arm_scale_f32(float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+        pDst[i] = pSrc[i] * scale;
+}
+
+void arm_negate_f32(float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+        pDst[i] = -pSrc[i];
+}
+
+void arm_dot_prod_f32(float32_t *pSrcA, float32_t *pSrcB, uint32_t blockSize, float32_t *result)
+{
+    float32_t sum = 0;
+    for (uint32_t i = 0; i < blockSize; i++)
+        sum += pSrcA[i] * pSrcB[i];
+    *result = sum;
+}
+
+void arm_cmplx_mult_cmplx_f32(float32_t *pSrcA, float32_t *pSrcB, float32_t *pDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        const float32_t re = pSrcA[2 * i] * pSrcB[2 * i] - pSrcA[2 * i + 1] * pSrcB[2 * i + 1];
+        const float32_t im = pSrcA[2 * i] * pSrcB[2 * i + 1] + pSrcA[2 * i + 1] * pSrcB[2 * i];
+        pDst[2 * i + 0] = re;
+        pDst[2 * i + 1] = im;
+    }
+}
+
+void arm_fir_init_f32(arm_fir_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, uint32_t blockSize)
+{
+    S->numTaps = numTaps;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+    std::fill(pState, pState + numTaps + blockSize - 1, 0.0f);
+}
+
+void arm_fir_f32(const arm_fir_instance_f32 *S, float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    /* State holds (numTaps - 1) previous samples followed by current block, coefficients are time reversed */
+    const uint32_t taps = S->numTaps;
+    float32_t *state = S->pState;
+    std::copy(pSrc, pSrc + blockSize, state + taps - 1);
+
+    for (uint32_t n = 0; n < blockSize; n++)
+    {
+        float32_t acc = 0;
+        for (uint32_t k = 0; k < taps; k++)
+            acc += S->pCoeffs[k] * state[n + k];
+        pDst[n] = acc;
+    }
+
+    std::copy(state + blockSize, state + blockSize + taps - 1, state);
+}
+
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages, float32_t *pCoeffs, float32_t *pState)
+{
+    S->numStages = numStages;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+    std::fill(pState, pState + 2 * numStages, 0.0f);
+}
+
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    const float32_t *in = pSrc;
+
+    for (uint32_t s = 0; s < S->numStages; s++)
+    {
+        const float32_t *c = S->pCoeffs + 5 * s;
+        float32_t &d1 = S->pState[2 * s + 0];
+        float32_t &d2 = S->pState[2 * s + 1];
+
+        for (uint32_t i = 0; i < blockSize; i++)
+        {
+            const float32_t x = in[i];
+            const float32_t y = c[0] * x + d1;
+            d1 = c[1] * x + c[3] * y + d2;
+            d2 = c[2] * x + c[4] * y;
+            pDst[i] = y;
+        }
+
+        in = pDst;
+    }
+}
+
+float32_t arm_sin_f32(float32_t x)
+{
+    return std::sin(x);
+}
+
+float32_t arm_cos_f32(float32_t x)
+{
+    return std::cos(x);
+}
@@ -0,0 +1,20 @@
+/*
+ * core_cm0.h
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef TESTS_HOST_CORE_CM0_H_
+#define TESTS_HOST_CORE_CM0_H_
+
+/* Minimal core header for host builds of CMSIS DSP header (arm_math.h with ARM_MATH_CM0) */
+
+#include <stdint.h>
+
+#define __INLINE inline
+#define __STATIC_INLINE static inline
+#define __ASM asm
+#define __CLZ __builtin_clz
+
+#endif /* TESTS_HOST_CORE_CM0_H_ */
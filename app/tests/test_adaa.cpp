@@ -0,0 +1,102 @@
+/*
+ * test_adaa.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "test_utils.hpp"
+
+#include <libs/audio_dsp.hpp>
+
+//-----------------------------------------------------------------------------
+/* private */
+
+namespace
+{
+
+using namespace libs::adsp;
+
+std::vector<float> sine(float freq, float amplitude, uint32_t fs, size_t samples)
+{
+    std::vector<float> x(samples);
+    for (size_t n = 0; n < samples; n++)
+        x[n] = amplitude * std::sin(2 * pi * freq * n / fs);
+    return x;
+}
+
+/*
+ * For slowly varying input ADAA converges to direct shaper applied to input delayed by the same kernel,
+ * difference must shrink with rate of change of input
+ */
+template<typename shaper, uint8_t order>
+void test_slow_input(const char *name)
+{
+    struct { float freq; double limit; } cases[] {{20, 2e-3}, {5, 5e-4}, {1, 1e-4}};
+
+    for (auto &&c : cases)
+    {
+        adaa<shaper, order> a;
+        double err = 0;
+
+        for (float x : sine(c.freq, 2, 48000, 96000))
+        {
+            const float y = a.process(x);
+            err = std::max(err, std::abs(static_cast<double>(y) - shaper::f(a.dry())));
+        }
+
+        char what[96];
+        std::snprintf(what, sizeof(what), "%s, order %u: %g Hz input vs direct shaper", name, order, c.freq);
+        tests::expect_below(err, c.limit, what);
+    }
+}
+
+/* At high drive input jumps over whole range of shaper, output must stay within range of shaper (up to rounding) */
+template<typename shaper, uint8_t order>
+void test_high_drive(const char *name, double limit)
+{
+    for (uint32_t fs : {48000u, 96000u})
+    {
+        for (float gain : {1.0f, 10.0f, 50.0f, 200.0f, 1000.0f})
+        {
+            adaa<shaper, order> a;
+            double peak = 0;
+
+            for (float x : sine(82, gain, fs, fs / 2))
+            {
+                const float y = a.process(x);
+                peak = std::isfinite(y) ? std::max(peak, static_cast<double>(std::abs(y))) : INFINITY;
+            }
+
+            char what[96];
+            std::snprintf(what, sizeof(what), "%s, order %u: peak at gain %g, %u Hz", name, order, gain, fs);
+            tests::expect_below(peak, limit, what);
+        }
+    }
+}
+
+template<typename shaper>
+void test_shaper(const char *name, double limit)
+{
+    test_slow_input<shaper, 1>(name);
+    test_slow_input<shaper, 2>(name);
+    test_high_drive<shaper, 1>(name, limit);
+    test_high_drive<shaper, 2>(name, limit);
+}
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+int main(void)
+{
+    /* Sup |f| of each shaper with margin for rounding of 1-st order divided difference */
+    constexpr double margin {1 + 1e-5};
+    test_shaper<hard_clip_shaper>("hard clip", margin);
+    test_shaper<soft_clip_shaper>("soft clip", margin);
+    test_shaper<tanh_shaper>("tanh", margin);
+    test_shaper<atan_shaper>("atan", pi / 2 * margin);
+
+    return tests::result();
+}
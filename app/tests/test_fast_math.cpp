@@ -0,0 +1,114 @@
+/*
+ * test_fast_math.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "test_utils.hpp"
+
+#include <libs/fast_math.hpp>
+
+//-----------------------------------------------------------------------------
+/* private */
+
+namespace
+{
+
+using libs::adsp::fastmath::precision;
+namespace fm = libs::adsp::fastmath;
+
+constexpr uint32_t points {200001};
+
+enum class error_type { absolute, relative };
+
+/* Max error of approximation 'f' against reference 'ref' over points spaced linearly (or logarithmically) in [a, b] */
+template<typename F, typename R>
+double max_error(F &&f, R &&ref, double a, double b, error_type type, bool log_spaced = false)
+{
+    double err = 0;
+    for (uint32_t i = 0; i < points; i++)
+    {
+        const double t = static_cast<double>(i) / (points - 1);
+        const float x = log_spaced ? a * std::pow(b / a, t) : a + (b - a) * t;
+
+        const double expected = ref(static_cast<double>(x));
+        const double e = std::abs(f(x) - expected);
+        err = std::max(err, type == error_type::relative ? e / std::abs(expected) : e);
+    }
+    return err;
+}
+
+void test_exp2(void)
+{
+    const auto ref = [](double x) { return std::exp2(x); };
+    tests::expect_below(max_error(fm::exp2<precision::low>, ref, -126, 127.99, error_type::relative), 7.5e-5, "exp2 (low)");
+    tests::expect_below(max_error(fm::exp2<precision::high>, ref, -126, 127.99, error_type::relative), 1.7e-7, "exp2 (high)");
+}
+
+void test_exp(void)
+{
+    const auto ref = [](double x) { return std::exp(x); };
+    tests::expect_below(max_error(fm::exp<precision::low>, ref, -80, 80, error_type::relative), 7.9e-5, "exp (low)");
+    tests::expect_below(max_error(fm::exp<precision::high>, ref, -80, 80, error_type::relative), 3.9e-6, "exp (high)");
+}
+
+void test_log2(void)
+{
+    const auto ref = [](double x) { return std::log2(x); };
+    const double a = std::exp2(-32), b = std::exp2(32);
+    tests::expect_below(max_error(fm::log2<precision::low>, ref, a, b, error_type::absolute, true), 1.2e-5, "log2 (low)");
+    tests::expect_below(max_error(fm::log2<precision::high>, ref, a, b, error_type::absolute, true), 1.1e-6, "log2 (high)");
+    tests::expect_below(max_error(fm::log2<precision::high>, ref, 0.01, 100, error_type::absolute, true), 3.8e-7, "log2 (high, x in [0.01, 100])");
+}
+
+void test_pow(void)
+{
+    constexpr float y {2.4f};
+    const auto ref = [](double x) { return std::pow(x, static_cast<double>(y)); };
+    const auto low = [](float x) { return fm::pow<precision::low>(x, y); };
+    const auto high = [](float x) { return fm::pow<precision::high>(x, y); };
+    tests::expect_below(max_error(low, ref, 0.01, 100, error_type::relative, true), 9.4e-5, "pow (low)");
+    tests::expect_below(max_error(high, ref, 0.01, 100, error_type::relative, true), 1.4e-6, "pow (high)");
+}
+
+void test_tanh(void)
+{
+    const auto ref = [](double x) { return std::tanh(x); };
+    tests::expect_below(max_error(fm::tanh<precision::low>, ref, -20, 20, error_type::absolute), 9.6e-5, "tanh (low)");
+    tests::expect_below(max_error(fm::tanh<precision::high>, ref, -20, 20, error_type::absolute), 1.6e-7, "tanh (high)");
+}
+
+void test_atan(void)
+{
+    const auto ref = [](double x) { return std::atan(x); };
+    tests::expect_below(max_error(fm::atan<precision::low>, ref, -100, 100, error_type::absolute), 1.7e-4, "atan (low)");
+    tests::expect_below(max_error(fm::atan<precision::high>, ref, -100, 100, error_type::absolute), 6.1e-7, "atan (high)");
+}
+
+void test_tan(void)
+{
+    /* Poles are excluded, rounding of (pi/2 - x) is amplified there */
+    const auto ref = [](double x) { return std::tan(x); };
+    const double a = -0.45 * M_PI, b = 0.45 * M_PI;
+    tests::expect_below(max_error(fm::tan<precision::low>, ref, a, b, error_type::relative), 6.2e-4, "tan (low)");
+    tests::expect_below(max_error(fm::tan<precision::high>, ref, a, b, error_type::relative), 3.5e-6, "tan (high)");
+}
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+int main(void)
+{
+    test_exp2();
+    test_exp();
+    test_log2();
+    test_pow();
+    test_tanh();
+    test_atan();
+    test_tan();
+
+    return tests::result();
+}
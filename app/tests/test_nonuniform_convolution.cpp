@@ -0,0 +1,110 @@
+/*
+ * test_nonuniform_convolution.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "test_utils.hpp"
+
+#include <libs/audio_dsp.hpp>
+
+#include <memory>
+
+//-----------------------------------------------------------------------------
+/* private */
+
+namespace
+{
+
+/* Runs convolution block by block (optionally in-place) over signal of length being multiple of block_size */
+template<uint16_t block_size, uint32_t ir_size>
+std::vector<float> run(const std::vector<float> &ir, const std::vector<float> &x, bool in_place)
+{
+    using convolution = libs::adsp::nonuniform_convolution<block_size, ir_size>;
+
+    std::vector<float> memory(convolution::memory_size);
+    auto conv = std::make_unique<convolution>(memory.data());
+    conv->set_ir(ir.data());
+
+    std::vector<float> y(x.size());
+    for (size_t i = 0; i < x.size(); i += block_size)
+    {
+        if (in_place)
+        {
+            std::copy(x.begin() + i, x.begin() + i + block_size, y.begin() + i);
+            conv->process(y.data() + i, y.data() + i);
+        }
+        else
+        {
+            conv->process(x.data() + i, y.data() + i);
+        }
+    }
+
+    return y;
+}
+
+/* Signal long enough to pass through all stages, with length being multiple of block size */
+template<uint16_t block_size, uint32_t ir_size>
+std::vector<float> make_input(uint32_t seed)
+{
+    return tests::noise((ir_size / block_size + 16) * block_size, seed);
+}
+
+/* Decaying noise (as cabinet or reverb IR) */
+std::vector<float> make_ir(size_t samples, uint32_t seed)
+{
+    auto ir = tests::noise(samples, seed);
+    for (size_t n = 0; n < samples; n++)
+        ir[n] *= std::exp(-4.0f * n / samples);
+    return ir;
+}
+
+/* Unit impulse at given position is pure delay, so it must be reproduced (almost) exactly by each stage */
+template<uint16_t block_size, uint32_t ir_size>
+void test_impulse(uint32_t position)
+{
+    std::vector<float> ir(ir_size, 0.0f);
+    ir[position] = 1;
+
+    const auto x = make_input<block_size, ir_size>(1);
+    const auto y = run<block_size, ir_size>(ir, x, false);
+
+    char what[96];
+    std::snprintf(what, sizeof(what), "impulse at %u (block %u, IR %u)", position, block_size, ir_size);
+    tests::expect_below(tests::max_abs_error(x, y, position), 1e-5, what);
+}
+
+template<uint16_t block_size, uint32_t ir_size>
+void test_random(bool in_place)
+{
+    const auto ir = make_ir(ir_size, 2);
+    const auto x = make_input<block_size, ir_size>(3);
+    const auto y = run<block_size, ir_size>(ir, x, in_place);
+    const auto ref = tests::convolve(x, ir.data(), ir.size());
+
+    char what[96];
+    std::snprintf(what, sizeof(what), "random IR vs direct (block %u, IR %u%s)", block_size, ir_size, in_place ? ", in-place" : "");
+    tests::expect_below(tests::max_abs_error(ref, y), 1e-4, what);
+}
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+int main(void)
+{
+    /* Positions in direct FIR head, first stage, at partition & stage boundaries, in the last stage */
+    for (uint32_t position : {0u, 127u, 128u, 511u, 512u, 1000u, 2047u, 2048u, 7999u})
+        test_impulse<128, 8000>(position);
+
+    /* IR lengths not being multiples of block or partition size */
+    test_random<128, 8000>(false);
+    test_random<128, 8000>(true);
+    test_random<32, 5000>(false);
+    test_random<32, 5000>(true);
+    test_random<64, 100>(false);
+
+    return tests::result();
+}
@@ -0,0 +1,138 @@
+/*
+ * test_partitioned_convolution.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "test_utils.hpp"
+
+#include <libs/audio_dsp.hpp>
+
+#include <memory>
+
+//-----------------------------------------------------------------------------
+/* private */
+
+namespace
+{
+
+/* The same configuration as in cabinet simulator */
+constexpr uint16_t block_size {128};
+constexpr uint32_t ir_size {2048};
+
+/* IR lengths selected by quality levels of cabinet simulator */
+constexpr uint32_t quality_lengths[] {512, 1024, 2048};
+
+constexpr size_t signal_blocks {40};
+
+using partitioned = libs::adsp::partitioned_convolution<block_size, ir_size>;
+
+/* Decaying noise (as cabinet IR) */
+std::vector<float> make_ir(void)
+{
+    auto ir = tests::noise(ir_size, 1);
+    for (size_t n = 0; n < ir_size; n++)
+        ir[n] *= std::exp(-4.0f * n / ir_size);
+    return ir;
+}
+
+template<typename convolution>
+void process_blocks(convolution &conv, const std::vector<float> &x, std::vector<float> &y, size_t first, size_t last)
+{
+    for (size_t i = first * block_size; i < last * block_size; i += block_size)
+        conv.process(x.data() + i, y.data() + i);
+}
+
+/* Single FFT overlap-save convolution with IR truncated to given length as reference */
+template<uint16_t length>
+std::vector<float> run_fast_convolution(const std::vector<float> &ir, const std::vector<float> &x)
+{
+    auto conv = std::make_unique<libs::adsp::fast_convolution<block_size, length>>();
+    conv->set_ir(ir.data());
+
+    std::vector<float> y(x.size());
+    process_blocks(*conv, x, y, 0, signal_blocks);
+    return y;
+}
+
+template<uint16_t length>
+void test_against_fast_convolution(const std::vector<float> &ir, const std::vector<float> &x)
+{
+    auto conv = std::make_unique<partitioned>();
+    conv->set_ir(ir.data());
+    conv->set_length(length);
+
+    std::vector<float> y(x.size());
+    process_blocks(*conv, x, y, 0, signal_blocks);
+
+    const auto ref = run_fast_convolution<length>(ir, x);
+    const auto direct = tests::convolve(x, ir.data(), length);
+
+    char what[96];
+    std::snprintf(what, sizeof(what), "partitioned vs fast convolution (length %u)", length);
+    tests::expect_below(tests::max_abs_error(ref, y), 1e-4, what);
+    std::snprintf(what, sizeof(what), "partitioned vs direct convolution (length %u)", length);
+    tests::expect_below(tests::max_abs_error(direct, y), 1e-4, what);
+}
+
+void test_length_rounding(void)
+{
+    partitioned conv;
+
+    conv.set_length(1000);
+    tests::expect(conv.get_length() == 1024, "length is rounded up to whole partitions");
+    conv.set_length(0);
+    tests::expect(conv.get_length() == block_size, "at least one partition is used");
+    conv.set_length(4 * ir_size);
+    tests::expect(conv.get_length() == ir_size, "length is limited to IR size");
+}
+
+/* Quality is changed while processing, output must follow truncated IR from the first block after change */
+void test_length_switch(const std::vector<float> &ir, const std::vector<float> &x)
+{
+    auto conv = std::make_unique<partitioned>();
+    conv->set_ir(ir.data());
+
+    std::vector<float> y(x.size());
+    size_t block = 0;
+
+    for (uint32_t length : {2048u, 512u, 1024u, 2048u})
+    {
+        conv->set_length(length);
+
+        const size_t next_block = block + signal_blocks / 4;
+        process_blocks(*conv, x, y, block, next_block);
+
+        /* Compare only blocks processed with current length */
+        const auto ref = tests::convolve(x, ir.data(), length);
+        const std::vector<float> expected(ref.begin() + block * block_size, ref.begin() + next_block * block_size);
+        const std::vector<float> actual(y.begin() + block * block_size, y.begin() + next_block * block_size);
+
+        char what[96];
+        std::snprintf(what, sizeof(what), "blocks %zu-%zu after switch to length %u", block, next_block - 1, length);
+        tests::expect_below(tests::max_abs_error(expected, actual), 1e-4, what);
+
+        block = next_block;
+    }
+}
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+int main(void)
+{
+    const auto ir = make_ir();
+    const auto x = tests::noise(signal_blocks * block_size, 2);
+
+    test_against_fast_convolution<quality_lengths[0]>(ir, x);
+    test_against_fast_convolution<quality_lengths[1]>(ir, x);
+    test_against_fast_convolution<quality_lengths[2]>(ir, x);
+
+    test_length_rounding();
+    test_length_switch(ir, x);
+
+    return tests::result();
+}
@@ -0,0 +1,114 @@
+/*
+ * test_unicomb.cpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#include "test_utils.hpp"
+
+#include <libs/audio_dsp.hpp>
+
+//-----------------------------------------------------------------------------
+/* private */
+
+namespace
+{
+
+constexpr uint32_t fs {48000};
+constexpr uint32_t memory_length {1024};
+
+/* Block lengths shorter & longer than internal chunk (64 samples) */
+constexpr uint32_t block_lengths[] {1, 7, 64, 128, 33, 100};
+
+struct comb_pair
+{
+    std::vector<float> memory_a, memory_b;
+    libs::adsp::unicomb a, b;
+
+    comb_pair(float delay_samples) :
+    memory_a(memory_length), memory_b(memory_length),
+    a {0.7f, 0.5f, 0.3f, memory_a.data(), memory_length, fs},
+    b {0.7f, 0.5f, 0.3f, memory_b.data(), memory_length, fs}
+    {
+        for (auto &&c : {&this->a, &this->b})
+        {
+            c->set_delay(delay_samples / fs);
+            c->set_lowpass(3000);
+        }
+    }
+};
+
+/* Per-sample output of 'a' is compared with block output of 'b', blocks of varying length */
+template<bool lowpass_enabled, bool intrpl_enabled, uint32_t delay_tap = 0>
+void test_fixed_delay(float delay_samples, const char *what)
+{
+    comb_pair comb {delay_samples};
+    const auto x = tests::noise(4096, 1);
+    std::vector<float> y_sample(x.size()), y_block(x.size());
+
+    for (size_t i = 0; i < x.size(); i++)
+        y_sample[i] = comb.a.process<lowpass_enabled, intrpl_enabled, delay_tap>(x[i]);
+
+    for (size_t i = 0, k = 0; i < x.size(); k++)
+    {
+        const uint32_t n = std::min<size_t>(block_lengths[k % std::size(block_lengths)], x.size() - i);
+        comb.b.process<lowpass_enabled, intrpl_enabled, delay_tap>(x.data() + i, y_block.data() + i, n);
+        i += n;
+    }
+
+    tests::expect_below(tests::max_abs_error(y_sample, y_block), 1e-6, what);
+}
+
+/*
+ * Per-sample delay change with allpass interpolation is equivalent to block with per-sample delays. Delay set in
+ * seconds is converted back to samples with rounding error of fraction, so the bound is looser.
+ */
+template<bool lowpass_enabled>
+void test_modulated_delay(const char *what)
+{
+    comb_pair comb {0};
+    const auto x = tests::noise(4096, 2);
+    std::vector<float> y_sample(x.size()), y_block(x.size());
+
+    /* Slow LFO between 30 & 300 samples (fractional) */
+    std::vector<float> delays(x.size());
+    for (size_t i = 0; i < delays.size(); i++)
+        delays[i] = 165.25f + 134.5f * std::sin(2 * libs::adsp::pi * i / 2000);
+
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        comb.a.set_delay(delays[i] / fs);
+        y_sample[i] = comb.a.process<lowpass_enabled, true>(x[i]);
+    }
+
+    for (size_t i = 0, k = 0; i < x.size(); k++)
+    {
+        const uint32_t n = std::min<size_t>(block_lengths[k % std::size(block_lengths)], x.size() - i);
+        comb.b.process<lowpass_enabled, true>(x.data() + i, y_block.data() + i, delays.data() + i, n);
+        i += n;
+    }
+
+    tests::expect_below(tests::max_abs_error(y_sample, y_block), 1e-4, what);
+}
+
+}
+
+//-----------------------------------------------------------------------------
+/* public */
+
+int main(void)
+{
+    test_fixed_delay<false, false>(10, "short delay (shorter than block)");
+    test_fixed_delay<false, false>(200, "long delay");
+    test_fixed_delay<true, false>(200, "lowpass in feedback");
+    test_fixed_delay<false, true>(150.3f, "allpass interpolated delay");
+    test_fixed_delay<true, true>(37.7f, "lowpass & allpass interpolated delay");
+    test_fixed_delay<false, false, 5>(100, "feedback from delay tap");
+    test_fixed_delay<true, false, 80>(300, "lowpass & feedback from delay tap");
+
+    test_modulated_delay<false>("modulated delay");
+    test_modulated_delay<true>("modulated delay & lowpass");
+
+    return tests::result();
+}
@@ -0,0 +1,84 @@
+/*
+ * test_utils.hpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef TESTS_TEST_UTILS_HPP_
+#define TESTS_TEST_UTILS_HPP_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+/* Minimal helpers for host unit tests, each test is a program that returns non-zero exit code on failure */
+namespace tests
+{
+
+inline int failures {0};
+
+inline void expect(bool condition, const char *what)
+{
+    std::printf("%s %s\n", condition ? "[  OK  ]" : "[FAILED]", what);
+    if (!condition)
+        failures++;
+}
+
+inline void expect_below(double value, double limit, const char *what)
+{
+    const bool ok = value <= limit;
+    std::printf("%s %s: %.3g (limit %.3g)\n", ok ? "[  OK  ]" : "[FAILED]", what, value, limit);
+    if (!ok)
+        failures++;
+}
+
+inline int result(void)
+{
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Uniform white noise in [-1, 1] */
+inline std::vector<float> noise(size_t samples, uint32_t seed)
+{
+    std::mt19937 gen {seed};
+    std::uniform_real_distribution<float> dist {-1, 1};
+
+    std::vector<float> x(samples);
+    for (auto &&v : x)
+        v = dist(gen);
+    return x;
+}
+
+/* Reference direct convolution (in double precision), output has the same length as input */
+inline std::vector<float> convolve(const std::vector<float> &x, const float *ir, size_t ir_len)
+{
+    std::vector<float> y(x.size());
+    for (size_t n = 0; n < x.size(); n++)
+    {
+        double acc = 0;
+        for (size_t k = 0; k < ir_len && k <= n; k++)
+            acc += static_cast<double>(ir[k]) * x[n - k];
+        y[n] = acc;
+    }
+    return y;
+}
+
+/* Max absolute difference of signals, 'b' is compared from given offset (e.g. latency) */
+inline double max_abs_error(const std::vector<float> &a, const std::vector<float> &b, size_t offset = 0)
+{
+    double err = 0;
+    for (size_t n = 0; n + offset < b.size() && n < a.size(); n++)
+        err = std::max(err, std::abs(static_cast<double>(a[n]) - b[n + offset]));
+    return err;
+}
+
+}
+
+#endif /* TESTS_TEST_UTILS_HPP_ */
@@ -159,6 +159,7 @@ struct effect_bypass_changed
 struct effect_controls_changed
 {
     effect_controls ctrl;
+    controls_mask changed; // Fields changed by user
 };
 
 struct add_effect_request
@@ -28,7 +28,7 @@ void notify_effect_bypass_changed(lv_obj_t *obj, mfx::effect_id effect)
     view->notify(events::effect_bypass_changed {effect, bypassed});
 }
 
-void notify_tuner_controls_changed(void)
+void notify_tuner_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *mute_btn = ui_btn_tuner_mute;
 
@@ -38,10 +38,10 @@ void notify_tuner_controls_changed(void)
         mfx::tuner_attr::default_ctrl.a4_tuning // Changing tuning frequency is not supported yet
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_tremolo_controls_changed(void)
+void notify_tremolo_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *rate_knob = ui_arc_trem_rate;
     lv_obj_t *depth_knob = ui_arc_trem_depth;
@@ -56,10 +56,10 @@ void notify_tremolo_controls_changed(void)
         mfx::tremolo_attr::controls::shape_type::sine
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_echo_controls_changed(void)
+void notify_echo_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *blur_knob = ui_arc_echo_blur;
     lv_obj_t *time_knob = ui_arc_echo_time;
@@ -76,10 +76,10 @@ void notify_echo_controls_changed(void)
         mfx::echo_attr::controls::mode_type::echo
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_chorus_controls_changed(void)
+void notify_chorus_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *mix_knob = ui_arc_chorus_mix;
     lv_obj_t *depth_knob = ui_arc_chorus_depth;
@@ -97,10 +97,10 @@ void notify_chorus_controls_changed(void)
         mfx::chorus_attr::controls::mode_type::white
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_reverb_controls_changed(void)
+void notify_reverb_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *bw_knob = ui_arc_reverb_bw;
     lv_obj_t *damp_knob = ui_arc_reverb_damp;
@@ -117,10 +117,10 @@ void notify_reverb_controls_changed(void)
         mfx::reverb_attr::controls::mode_type::plate
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_overdrive_controls_changed(void)
+void notify_overdrive_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *mix_knob = ui_arc_od_mix;
     lv_obj_t *gain_knob = ui_arc_od_gain;
@@ -138,10 +138,10 @@ void notify_overdrive_controls_changed(void)
         mfx::overdrive_attr::controls::mode_type::soft
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_cabinet_sim_controls_changed(void)
+void notify_cabinet_sim_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *ir_list = ui_roller_cab_sim_ir;
 
@@ -151,10 +151,10 @@ void notify_cabinet_sim_controls_changed(void)
         mfx::cabinet_sim_attr::controls::resolution::standart,
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_vocoder_controls_changed(void)
+void notify_vocoder_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *clarity_knob = ui_arc_voc_clarity;
     lv_obj_t *bands_list = ui_roller_voc_bands;
@@ -177,10 +177,10 @@ void notify_vocoder_controls_changed(void)
         mfx::vocoder_attr::controls::mode_type::vintage
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_phaser_controls_changed(void)
+void notify_phaser_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *rate_knob = ui_arc_pha_rate;
     lv_obj_t *depth_knob = ui_arc_pha_depth;
@@ -195,10 +195,10 @@ void notify_phaser_controls_changed(void)
         mfx::phaser_attr::controls::contour_mode::off
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_amp_sim_controls_changed(void)
+void notify_amp_sim_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *input_knob = ui_arc_amp_sim_input;
     lv_obj_t *drive_knob = ui_arc_amp_sim_drive;
@@ -221,10 +221,10 @@ void notify_amp_sim_controls_changed(void)
         mfx::amp_sim_attr::controls::mode_type::logain
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
-void notify_nam_controls_changed(void)
+void notify_nam_controls_changed(mfx::controls_mask changed)
 {
     lv_obj_t *models_list = ui_roller_nam_models;
     lv_obj_t *volume_knob = ui_arc_nam_volume;
@@ -236,7 +236,7 @@ void notify_nam_controls_changed(void)
         static_cast<float>(lv_arc_get_value(volume_knob)) * 0.01f,
     };
 
-    view->notify(events::effect_controls_changed {ctrl});
+    view->notify(events::effect_controls_changed {ctrl, changed});
 }
 
 }
@@ -377,7 +377,7 @@ void ui_tuner_bypass(lv_event_t * e)
 
 void ui_tuner_mute(lv_event_t * e)
 {
-    notify_tuner_controls_changed();
+    notify_tuner_controls_changed(mfx::tuner_attr::controls::mute_field);
 }
 
 void ui_tremolo_bypass(lv_event_t * e)
@@ -387,17 +387,17 @@ void ui_tremolo_bypass(lv_event_t * e)
 
 void ui_tremolo_rate_changed(lv_event_t * e)
 {
-    notify_tremolo_controls_changed();
+    notify_tremolo_controls_changed(mfx::tremolo_attr::controls::rate_field);
 }
 
 void ui_tremolo_depth_changed(lv_event_t * e)
 {
-    notify_tremolo_controls_changed();
+    notify_tremolo_controls_changed(mfx::tremolo_attr::controls::depth_field);
 }
 
 void ui_tremolo_shape_changed(lv_event_t * e)
 {
-    notify_tremolo_controls_changed();
+    notify_tremolo_controls_changed(mfx::tremolo_attr::controls::shape_field);
 }
 
 void ui_echo_bypass(lv_event_t * e)
@@ -407,22 +407,22 @@ void ui_echo_bypass(lv_event_t * e)
 
 void ui_echo_blur_changed(lv_event_t * e)
 {
-    notify_echo_controls_changed();
+    notify_echo_controls_changed(mfx::echo_attr::controls::blur_field);
 }
 
 void ui_echo_feedb_changed(lv_event_t * e)
 {
-    notify_echo_controls_changed();
+    notify_echo_controls_changed(mfx::echo_attr::controls::feedback_field);
 }
 
 void ui_echo_time_changed(lv_event_t * e)
 {
-    notify_echo_controls_changed();
+    notify_echo_controls_changed(mfx::echo_attr::controls::time_field);
 }
 
 void ui_echo_mode_changed(lv_event_t * e)
 {
-    notify_echo_controls_changed();
+    notify_echo_controls_changed(mfx::echo_attr::controls::mode_field);
 }
 
 void ui_chorus_bypass(lv_event_t * e)
@@ -432,22 +432,22 @@ void ui_chorus_bypass(lv_event_t * e)
 
 void ui_chorus_mix_changed(lv_event_t * e)
 {
-    notify_chorus_controls_changed();
+    notify_chorus_controls_changed(mfx::chorus_attr::controls::mix_field);
 }
 
 void ui_chorus_rate_changed(lv_event_t * e)
 {
-    notify_chorus_controls_changed();
+    notify_chorus_controls_changed(mfx::chorus_attr::controls::rate_field);
 }
 
 void ui_chorus_depth_changed(lv_event_t * e)
 {
-    notify_chorus_controls_changed();
+    notify_chorus_controls_changed(mfx::chorus_attr::controls::depth_field);
 }
 
 void ui_chorus_mode_changed(lv_event_t * e)
 {
-    notify_chorus_controls_changed();
+    notify_chorus_controls_changed(mfx::chorus_attr::controls::mode_field);
 }
 
 void ui_reverb_bypass(lv_event_t * e)
@@ -457,22 +457,22 @@ void ui_reverb_bypass(lv_event_t * e)
 
 void ui_reverb_bw_changed(lv_event_t * e)
 {
-    notify_reverb_controls_changed();
+    notify_reverb_controls_changed(mfx::reverb_attr::controls::bandwidth_field);
 }
 
 void ui_reverb_damp_changed(lv_event_t * e)
 {
-    notify_reverb_controls_changed();
+    notify_reverb_controls_changed(mfx::reverb_attr::controls::damping_field);
 }
 
 void ui_reverb_decay_changed(lv_event_t * e)
 {
-    notify_reverb_controls_changed();
+    notify_reverb_controls_changed(mfx::reverb_attr::controls::decay_field);
 }
 
 void ui_reverb_mode_changed(lv_event_t * e)
 {
-    notify_reverb_controls_changed();
+    notify_reverb_controls_changed(mfx::reverb_attr::controls::mode_field);
 }
 
 void ui_overdrive_bypass(lv_event_t * e)
@@ -482,27 +482,27 @@ void ui_overdrive_bypass(lv_event_t * e)
 
 void ui_overdrive_mix_changed(lv_event_t * e)
 {
-    notify_overdrive_controls_changed();
+    notify_overdrive_controls_changed(mfx::overdrive_attr::controls::mix_field);
 }
 
 void ui_overdrive_low_changed(lv_event_t * e)
 {
-    notify_overdrive_controls_changed();
+    notify_overdrive_controls_changed(mfx::overdrive_attr::controls::low_field | mfx::overdrive_attr::controls::high_field);
 }
 
 void ui_overdrive_gain_changed(lv_event_t * e)
 {
-    notify_overdrive_controls_changed();
+    notify_overdrive_controls_changed(mfx::overdrive_attr::controls::gain_field);
 }
 
 void ui_overdrive_high_changed(lv_event_t * e)
 {
-    notify_overdrive_controls_changed();
+    notify_overdrive_controls_changed(mfx::overdrive_attr::controls::low_field | mfx::overdrive_attr::controls::high_field);
 }
 
 void ui_overdrive_mode_changed(lv_event_t * e)
 {
-    notify_overdrive_controls_changed();
+    notify_overdrive_controls_changed(mfx::overdrive_attr::controls::mode_field);
 }
 
 void ui_cab_sim_bypass(lv_event_t * e)
@@ -512,7 +512,7 @@ void ui_cab_sim_bypass(lv_event_t * e)
 
 void ui_cab_sim_ir_changed(lv_event_t * e)
 {
-    notify_cabinet_sim_controls_changed();
+    notify_cabinet_sim_controls_changed(mfx::cabinet_sim_attr::controls::ir_idx_field);
 }
 
 void ui_vocoder_bypass(lv_event_t * e)
@@ -522,27 +522,27 @@ void ui_vocoder_bypass(lv_event_t * e)
 
 void ui_vocoder_clarity_changed(lv_event_t * e)
 {
-    notify_vocoder_controls_changed();
+    notify_vocoder_controls_changed(mfx::vocoder_attr::controls::clarity_field);
 }
 
 void ui_vocoder_tone_changed(lv_event_t * e)
 {
-    notify_vocoder_controls_changed();
+    notify_vocoder_controls_changed(mfx::vocoder_attr::controls::tone_field);
 }
 
 void ui_vocoder_bands_changed(lv_event_t * e)
 {
-    notify_vocoder_controls_changed();
+    notify_vocoder_controls_changed(mfx::vocoder_attr::controls::bands_field);
 }
 
 void ui_vocoder_mode_changed(lv_event_t * e)
 {
-    notify_vocoder_controls_changed();
+    notify_vocoder_controls_changed(mfx::vocoder_attr::controls::mode_field);
 }
 
 void ui_vocoder_hold_changed(lv_event_t * e)
 {
-    notify_vocoder_controls_changed();
+    notify_vocoder_controls_changed(mfx::vocoder_attr::controls::hold_field);
 }
 
 void ui_phaser_bypass(lv_event_t * e)
@@ -552,17 +552,17 @@ void ui_phaser_bypass(lv_event_t * e)
 
 void ui_phaser_rate_changed(lv_event_t * e)
 {
-    notify_phaser_controls_changed();
+    notify_phaser_controls_changed(mfx::phaser_attr::controls::rate_field);
 }
 
 void ui_phaser_depth_changed(lv_event_t * e)
 {
-    notify_phaser_controls_changed();
+    notify_phaser_controls_changed(mfx::phaser_attr::controls::depth_field);
 }
 
 void ui_phaser_contour_changed(lv_event_t * e)
 {
-    notify_phaser_controls_changed();
+    notify_phaser_controls_changed(mfx::phaser_attr::controls::contour_field);
 }
 
 void ui_amp_sim_bypass(lv_event_t * e)
@@ -572,37 +572,37 @@ void ui_amp_sim_bypass(lv_event_t * e)
 
 void ui_amp_sim_input_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::input_field);
 }
 
 void ui_amp_sim_drive_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::drive_field);
 }
 
 void ui_amp_sim_compression_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::compression_field);
 }
 
 void ui_amp_sim_bass_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::bass_field);
 }
 
 void ui_amp_sim_mids_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::mids_field);
 }
 
 void ui_amp_sim_treb_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::treb_field);
 }
 
 void ui_amp_sim_mode_changed(lv_event_t * e)
 {
-    notify_amp_sim_controls_changed();
+    notify_amp_sim_controls_changed(mfx::amp_sim_attr::controls::mode_field);
 }
 
 void ui_nam_bypass(lv_event_t * e)
@@ -614,12 +614,12 @@ void ui_nam_bypass(lv_event_t * e)
 
 void ui_nam_model_changed(lv_event_t * e)
 {
-    notify_nam_controls_changed();
+    notify_nam_controls_changed(mfx::neural_amp_modeler_attr::controls::model_idx_field);
 }
 
 void ui_nam_volume_changed(lv_event_t * e)
 {
-    notify_nam_controls_changed();
+    notify_nam_controls_changed(mfx::neural_amp_modeler_attr::controls::out_vol_field);
 }
 
 
@@ -400,6 +400,93 @@ void audio_wm8994ecs::write_reg(uint16_t reg_addr, uint16_t reg_val)
     }
 }
 
+void audio_wm8994ecs::write_reg_async(uint16_t reg_addr, uint16_t reg_val)
+{
+    /* Called only from one context (owner of codec), slots are never released */
+    uint8_t slot = 0;
+    while (slot < this->async_slots_used && this->async_reg_addr[slot] != reg_addr)
+        slot++;
+
+    if (slot == this->async_slots_used)
+    {
+        assert(slot < async_slots);
+        this->async_reg_addr[slot] = reg_addr;
+        this->async_slots_used++;
+    }
+
+    /* If previous value is still pending it is simply overwritten */
+    this->async_reg_val[slot].store(reg_val, std::memory_order_relaxed);
+    this->async_pending.fetch_or(1ul << slot, std::memory_order_release);
+
+    this->flush_async_writes();
+}
+
+void audio_wm8994ecs::flush_async_writes(void)
+{
+    using transfer_desc = hal::interface::i2c_proxy::transfer_desc;
+
+    while (this->async_pending.load(std::memory_order_acquire) != 0)
+    {
+        /* Other context already sends, it will pick up pending writes from completion callback */
+        if (this->async_busy.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        const uint32_t pending = this->async_pending.load(std::memory_order_acquire);
+        if (pending == 0)
+        {
+            /* Drained by other context in the meantime, check again after releasing */
+            this->async_busy.store(false, std::memory_order_release);
+            continue;
+        }
+
+        /* Take first pending register & merge following ones with consecutive addresses */
+        uint8_t slot = __builtin_ctz(pending);
+        const uint16_t reg_addr = this->async_reg_addr[slot];
+        uint8_t tx[2 + 2 * async_max_burst]
+        {
+            static_cast<uint8_t>((reg_addr >> 8) & 0xFF),
+            static_cast<uint8_t>(reg_addr & 0xFF)
+        };
+        uint8_t words = 0;
+
+        while (true)
+        {
+            this->async_pending.fetch_and(~(1ul << slot), std::memory_order_acq_rel);
+            const uint16_t reg_val = this->async_reg_val[slot].load(std::memory_order_relaxed);
+            tx[2 + 2 * words] = static_cast<uint8_t>((reg_val >> 8) & 0xFF);
+            tx[3 + 2 * words] = static_cast<uint8_t>(reg_val & 0xFF);
+            words++;
+
+            if (words == async_max_burst)
+                break;
+
+            const uint32_t still_pending = this->async_pending.load(std::memory_order_acquire);
+            const uint16_t next_addr = reg_addr + words;
+            slot = 0;
+            while (slot < async_slots && !((still_pending & (1ul << slot)) && this->async_reg_addr[slot] == next_addr))
+                slot++;
+
+            if (slot == async_slots)
+                break;
+        }
+
+        const transfer_desc desc
+        {
+            this->i2c_addr,
+            reinterpret_cast<std::byte*>(tx),
+            2u + 2u * words,
+        };
+
+        this->i2c.transfer(desc,
+        [this](const transfer_desc &)
+        {
+            this->async_busy.store(false, std::memory_order_release);
+            this->flush_async_writes();
+        });
+        return;
+    }
+}
+
 uint16_t audio_wm8994ecs::read_id(void)
 {
     return this->read_reg(WM8994_SW_RESET);
@@ -938,12 +1025,12 @@ void audio_wm8994ecs::set_input_volume(uint8_t vol, uint8_t ch)
     switch (ch)
     {
         case 0: // Left
-            this->write_reg(WM8994_LEFT_LINE_IN12_VOL, vol | 0x0140);
-            this->write_reg(WM8994_AIF1_ADC2_LEFT_VOL, dvol | 0x100);
+            this->write_reg_async(WM8994_LEFT_LINE_IN12_VOL, vol | 0x0140);
+            this->write_reg_async(WM8994_AIF1_ADC2_LEFT_VOL, dvol | 0x100);
             break;
         case 1: // Right
-            this->write_reg(WM8994_RIGHT_LINE_IN12_VOL, vol | 0x0140);
-            this->write_reg(WM8994_AIF1_ADC2_RIGHT_VOL, dvol | 0x100);
+            this->write_reg_async(WM8994_RIGHT_LINE_IN12_VOL, vol | 0x0140);
+            this->write_reg_async(WM8994_AIF1_ADC2_RIGHT_VOL, dvol | 0x100);
             break;
         default:
             break;
@@ -988,11 +1075,15 @@ void audio_wm8994ecs::set_input_channels(frame_slots left_ch, frame_slots right_
         static_cast<uint16_t>((1 << left_slot) | (1 << right_slot)),
     };
 
-    this->mute(true);
+    /* Muting would be coalesced with unmuting, so queue it in order with SAI reconfiguration & restore state after */
+    this->write_reg(WM8994_DAC1_LEFT_VOL, 0x0200);
+    this->write_reg(WM8994_DAC1_RIGHT_VOL, 0x0200);
+    this->write_reg(WM8994_DAC2_LEFT_VOL, 0x0200);
+    this->write_reg(WM8994_DAC2_RIGHT_VOL, 0x0200);
     this->sai_drv.block_b.enable(false);
     this->sai_drv.block_b.configure(sai_b_cfg);
     this->sai_drv.block_b.enable(true);
-    this->mute(false);
+    this->mute(this->muted);
 }
 
 void audio_wm8994ecs::play(const audio_output::sample_t *output, uint16_t length, const play_cb_t &cb, bool loop)
@@ -1034,10 +1125,12 @@ void audio_wm8994ecs::mute(bool value)
     else
         regval = 0x00C0;
 
-    this->write_reg(WM8994_DAC1_LEFT_VOL, regval);
-    this->write_reg(WM8994_DAC1_RIGHT_VOL, regval);
-    this->write_reg(WM8994_DAC2_LEFT_VOL, regval);
-    this->write_reg(WM8994_DAC2_RIGHT_VOL, regval);
+    this->write_reg_async(WM8994_DAC1_LEFT_VOL, regval);
+    this->write_reg_async(WM8994_DAC1_RIGHT_VOL, regval);
+    this->write_reg_async(WM8994_DAC2_LEFT_VOL, regval);
+    this->write_reg_async(WM8994_DAC2_RIGHT_VOL, regval);
+
+    this->muted = value;
 }
 
 void audio_wm8994ecs::set_output_volume(uint8_t vol)
@@ -1048,10 +1141,10 @@ void audio_wm8994ecs::set_output_volume(uint8_t vol)
     constexpr uint8_t vol_6db = 0x3F;
     vol = std::clamp(vol, vol_m57db, vol_6db);
 
-    this->write_reg(WM8994_LEFT_OUTPUT_VOL, vol | 0x00C0);
-    this->write_reg(WM8994_RIGHT_OUTPUT_VOL, vol | 0x01C0);
-    this->write_reg(WM8994_SPK_LEFT_VOL, vol | 0x00C0);
-    this->write_reg(WM8994_SPK_RIGHT_VOL, vol | 0x01C0);
+    this->write_reg_async(WM8994_LEFT_OUTPUT_VOL, vol | 0x00C0);
+    this->write_reg_async(WM8994_RIGHT_OUTPUT_VOL, vol | 0x01C0);
+    this->write_reg_async(WM8994_SPK_LEFT_VOL, vol | 0x00C0);
+    this->write_reg_async(WM8994_SPK_RIGHT_VOL, vol | 0x01C0);
 
     this->output_volume = vol;
 }
@@ -10,6 +10,9 @@
 
 #include <hal_interface.hpp>
 
+#include <array>
+#include <atomic>
+
 #include <drivers/stm32.hpp>
 
 namespace drivers
@@ -49,6 +52,22 @@ private:
     uint16_t read_reg(uint16_t reg_addr);
     void write_reg(uint16_t reg_addr, uint16_t reg_val);
 
+    /*
+     * Runtime controls (volume & mute) don't wait for I2C: latest value of each register is kept in a slot
+     * and only one transfer is in flight, next one is started from its completion callback. Writes to
+     * consecutive registers are merged into single transfer (register address auto-increment).
+     */
+    void write_reg_async(uint16_t reg_addr, uint16_t reg_val);
+    void flush_async_writes(void);
+
+    static constexpr uint8_t async_slots {16};
+    static constexpr uint8_t async_max_burst {4};
+    std::array<uint16_t, async_slots> async_reg_addr {};
+    std::array<std::atomic<uint16_t>, async_slots> async_reg_val {};
+    std::atomic<uint32_t> async_pending {0};
+    std::atomic<bool> async_busy {false};
+    uint8_t async_slots_used {0};
+
     uint16_t read_id(void);
     void reset(void);
 
@@ -65,6 +84,7 @@ private:
 
     uint8_t input_volume[input_channels] {0, 0};
     uint8_t output_volume {0};
+    bool muted {false};
 };
 
 }
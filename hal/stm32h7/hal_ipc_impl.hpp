@@ -11,8 +11,10 @@
 #ifdef DUAL_CORE_APP
 
 #include <cstddef>
+#include <atomic>
 
 #include <drivers/stm32h7/exti.hpp>
+#include <drivers/stm32h7/hsem.hpp>
 
 #include "FreeRTOS.h"
 #include "message_buffer.h"
@@ -31,8 +33,14 @@ namespace hal::ipc
 
         channel cm4_to_cm7;
         channel cm7_to_cm4;
+
+        /* Memory of DSP pipeline (layout is defined by application), shared RAM is not cached by CM7 (see MPU setup) */
+        alignas(32) uint8_t dsp_pipeline[16384];
     };
 
+    /* HSEM guarding configuration part of DSP pipeline memory */
+    constexpr inline uint8_t dsp_pipeline_hsem_id = 2;
+
     inline ipc ipc_struct __attribute__((section(".ipc")));
 
     inline void init(void)
@@ -77,6 +85,34 @@ namespace hal::ipc
         return ipc_struct.cm7_to_cm4.initialized;
     }
 
+    inline void init_dsp_pipeline(std::function<void(void)> cm4_callback)
+    {
+        drivers::exti::configure(true,
+                                 drivers::exti::line::line2,
+                                 drivers::exti::port::none,
+                                 drivers::exti::mode::interrupt,
+                                 drivers::exti::edge::rising,
+                                 cm4_callback
+                                );
+    }
+
+    inline void notify_dsp_pipeline(void)
+    {
+        drivers::exti::trigger(drivers::exti::line::line2);
+    }
+
+    inline void lock_dsp_pipeline(void)
+    {
+        while (!drivers::hsem::fast_take(dsp_pipeline_hsem_id));
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    inline void unlock_dsp_pipeline(void)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        drivers::hsem::release(dsp_pipeline_hsem_id);
+    }
+
     inline size_t receive_from_cm7(void *data, size_t data_size, uint32_t timeout_ms = 0)
     {
         return xMessageBufferReceive(ipc_struct.cm7_to_cm4.mb_handle, data, data_size, timeout_ms);
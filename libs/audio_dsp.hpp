@@ -184,6 +184,233 @@ private:
     uint32_t counter_limit;
 };
 
+/* Sine for compile-time table generation (Taylor series) */
+constexpr double const_sin(double x)
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    while (x > pi) x -= 2 * pi;
+    while (x < -pi) x += 2 * pi;
+    if (x > pi / 2) x = pi - x;
+    if (x < -pi / 2) x = -pi - x;
+
+    double term = x, sum = x;
+    for (int k = 1; k < 12; k++)
+    {
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/* Single period of waveform (with guard point) built from Fourier series, phase & polarity as in 'oscillator' */
+template<uint32_t size, uint32_t harmonics>
+constexpr std::array<float, size + 1> make_wavetable(oscillator::shape s)
+{
+    constexpr double pi = 3.14159265358979323846;
+    std::array<float, size + 1> t {};
+
+    for (uint32_t i = 0; i <= size; i++)
+    {
+        const double x = 2 * pi * (i % size) / size;
+        double sum = 0;
+
+        if (s == oscillator::shape::sine)
+            sum = const_sin(x);
+
+        for (uint32_t k = 1; k <= harmonics; k++)
+        {
+            const double sigma = const_sin(pi * k / (harmonics + 1)) / (pi * k / (harmonics + 1));
+
+            if (s == oscillator::shape::sawtooth)
+                sum -= sigma * 2 / pi * const_sin(k * x) / k;
+            else if (s == oscillator::shape::square && (k % 2))
+                sum -= sigma * 4 / pi * const_sin(k * x) / k;
+            else if (s == oscillator::shape::triangle && (k % 2))
+                sum -= 8 / (pi * pi) * const_sin(k * x + pi / 2) / (k * k);
+        }
+
+        t[i] = sum;
+    }
+
+    return t;
+}
+
+/* Oscillator with 32-bit fractional phase accumulator & band-limited wavetables (waveforms match 'oscillator') */
+class wavetable_oscillator
+{
+public:
+    using shape = oscillator::shape;
+
+    wavetable_oscillator(shape shape, float freq, uint32_t fs) : fs{fs}
+    {
+        this->phase = 0;
+        this->noise = 1;
+        this->frequency = 0;
+        this->wave_shape = shape;
+        this->select_table();
+        this->set_frequency(freq);
+    }
+
+    void set_frequency(float f)
+    {
+        if (this->frequency == f || f <= 0)
+            return;
+
+        this->frequency = f;
+        this->phase_inc = static_cast<uint32_t>(static_cast<double>(f) / this->fs * 4294967296.0);
+    }
+
+    void set_shape(shape s)
+    {
+        if (this->wave_shape == s)
+            return;
+
+        this->wave_shape = s;
+        this->select_table();
+    }
+
+    /* Phase in range [0, 1) */
+    void set_phase(float p)
+    {
+        this->phase = static_cast<uint32_t>(p * 4294967296.0f);
+    }
+
+    float generate(void)
+    {
+        float out;
+        this->generate(&out, 1);
+        return out;
+    }
+
+    /* Returns current sample & advances phase by given number of samples (for control-rate evaluation) */
+    float advance(uint32_t samples)
+    {
+        const float out = this->generate();
+        this->phase += (samples - 1) * this->phase_inc;
+        return out;
+    }
+
+    void generate(float *out, uint32_t n)
+    {
+        if (this->wave_shape == shape::noise)
+        {
+            /* White noise from LCG, range: [-1, 1) */
+            uint32_t x = this->noise;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                x = 1664525 * x + 1013904223;
+                out[i] = static_cast<int32_t>(x) * (1.0f / 2147483648.0f);
+            }
+            this->noise = x;
+            return;
+        }
+
+        /* Linear interpolation between table points, table has guard point at the end */
+        const float *t = this->table;
+        const uint32_t inc = this->phase_inc;
+        uint32_t p = this->phase + this->phase_offset;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const uint32_t idx = p >> frac_bits;
+            const float frac = (p & frac_mask) * frac_scale;
+            const float s0 = t[idx];
+            out[i] = s0 + frac * (t[idx + 1] - s0);
+            p += inc;
+        }
+        this->phase = p - this->phase_offset;
+    }
+
+private:
+    constexpr static uint32_t table_bits {8};
+    constexpr static uint32_t table_size {1 << table_bits};
+    constexpr static uint32_t frac_bits {32 - table_bits};
+    constexpr static uint32_t frac_mask {(1 << frac_bits) - 1};
+    constexpr static float frac_scale {1.0f / (1 << frac_bits)};
+
+    typedef std::array<float, table_size + 1> table_t;
+
+    void select_table(void)
+    {
+        /* Cosine is sine shifted by 3/4 of period */
+        this->phase_offset = 0;
+
+        switch (this->wave_shape)
+        {
+        case shape::sawtooth:
+            this->table = sawtooth_table.data();
+            break;
+        case shape::square:
+            this->table = square_table.data();
+            break;
+        case shape::triangle:
+            this->table = triangle_table.data();
+            break;
+        case shape::cosine:
+            this->phase_offset = 3u << 30;
+            [[fallthrough]];
+        default:
+            this->table = sine_table.data();
+            break;
+        }
+    }
+
+    /* Band-limited tables (32 harmonics is enough for LFO use, Lanczos sigma factors suppress Gibbs ringing) */
+    constexpr static table_t sine_table {make_wavetable<table_size, 32>(shape::sine)};
+    constexpr static table_t sawtooth_table {make_wavetable<table_size, 32>(shape::sawtooth)};
+    constexpr static table_t square_table {make_wavetable<table_size, 32>(shape::square)};
+    constexpr static table_t triangle_table {make_wavetable<table_size, 32>(shape::triangle)};
+
+    const uint32_t fs;
+
+    shape wave_shape;
+    const float *table;
+    float frequency;
+    uint32_t phase;
+    uint32_t phase_inc;
+    uint32_t phase_offset;
+    uint32_t noise;
+};
+
+//-----------------------------------------------------------------------------
+
+/*
+ * Control-rate modulation: target value (e.g. filter coefficient or delay derived from LFO) is evaluated
+ * only every 'period' samples & linearly interpolated between control points.
+ */
+template<uint32_t period>
+class control_rate_modulator
+{
+public:
+    control_rate_modulator(float initial_value = 0) : value{initial_value} {}
+
+    /* Fills block with modulation values, 'eval(samples)' is called once per control period of given length */
+    template<typename F>
+    void process(float *out, uint32_t n, F &&eval)
+    {
+        for (uint32_t i = 0; i < n; i += period)
+        {
+            const uint32_t len = std::min(period, n - i);
+            const float start = this->value;
+            const float target = eval(len);
+            const float step = (target - start) / len;
+
+            for (uint32_t k = 0; k < len; k++)
+                out[i + k] = start + step * (k + 1);
+
+            this->value = target;
+        }
+    }
+
+    void reset(float v)
+    {
+        this->value = v;
+    }
+
+private:
+    float value;
+};
+
 //-----------------------------------------------------------------------------
 
 class delay_line
@@ -261,6 +488,95 @@ public:
         if (this->write_idx == this->memory_length)
             this->write_idx = 0;
     }
+
+    /* Contiguous part of delay line memory */
+    struct span
+    {
+        float *data;
+        uint32_t size;
+    };
+
+    /* Region of n samples starting d samples before write position, split at the wrap point */
+    std::array<span, 2> spans(uint32_t d, uint32_t n)
+    {
+        int32_t idx = this->write_idx - d;
+        if (idx < 0)
+            idx += this->memory_length;
+
+        const uint32_t first = std::min(n, this->memory_length - idx);
+        return {{ {this->memory + idx, first}, {this->memory, n - first} }};
+    }
+
+    void write(const float *in, uint32_t n)
+    {
+        for (auto &&s : this->spans(0, n))
+        {
+            arm_copy_f32(const_cast<float*>(in), s.data, s.size);
+            in += s.size;
+        }
+
+        this->write_idx += n;
+        if (this->write_idx >= this->memory_length)
+            this->write_idx -= this->memory_length;
+    }
+
+    /* Reads n samples at delay d relative to the next written sample (d >= n when called before 'write()') */
+    void read(float *out, uint32_t n, uint32_t d)
+    {
+        for (auto &&s : this->spans(d, n))
+        {
+            arm_copy_f32(s.data, out, s.size);
+            out += s.size;
+        }
+    }
+
+    template<bool interpolate = false>
+    void read(float *out, uint32_t n)
+    {
+        this->read(out, n, this->delay);
+        if constexpr (!interpolate) return;
+
+        /* Allpass interpolation (sequential, but without index arithmetic per sample) */
+        const float d = (1 - this->frac) / (1 + this->frac);
+        float s1 = this->at(this->delay + 1);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const float s0 = out[i];
+            out[i] = this->aph = s1 + d * (s0 - this->aph);
+            s1 = s0;
+        }
+    }
+
+    uint32_t get_delay(void) const
+    {
+        return this->delay;
+    }
+
+    /* Reads n samples with per-sample fractional delay (in samples, linear or allpass interpolation) */
+    template<bool allpass = false>
+    void read(float *out, const float *d, uint32_t n)
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const int32_t di = d[i];
+            const float frac = d[i] - di;
+
+            int32_t idx0 = this->write_idx + i - di;
+            if (idx0 < 0)
+                idx0 += this->memory_length;
+            else if (idx0 >= static_cast<int32_t>(this->memory_length))
+                idx0 -= this->memory_length;
+
+            const int32_t idx1 = (idx0 == 0) ? this->memory_length - 1 : idx0 - 1;
+
+            const float s0 = this->memory[idx0];
+            const float s1 = this->memory[idx1];
+            if constexpr (allpass)
+                out[i] = this->aph = s1 + (1 - frac) / (1 + frac) * (s0 - this->aph);
+            else
+                out[i] = s0 + frac * (s1 - s0);
+        }
+    }
 private:
     const uint32_t fs;
     const bool allocated;
@@ -409,139 +725,742 @@ private:
 
 //-----------------------------------------------------------------------------
 
-/* Exponential moving average filter */
-class averaging_filter
+/*
+ * Half-band FIR coefficients for x2 resampling stages of oversampler (equiripple, passband up to 20kHz @ 48kHz).
+ * Only non-zero side taps g[k] = h[c +/- (2k + 1)] are stored, center tap h[c] is 0.5 & other taps are zero.
+ */
+template<uint8_t depth>
+struct halfband_coeffs
+{
+    /* Stage 4x -> 8x (and higher): 7 taps, ~71dB stopband attenuation */
+    constexpr static std::array<float, 2> g
+    {
+        0.2837426992767366,-0.0338820426220230
+    };
+};
+
+template<>
+struct halfband_coeffs<0>
+{
+    /* Stage 1x -> 2x: 47 taps, ~69dB stopband attenuation (above 28kHz) */
+    constexpr static std::array<float, 12> g
+    {
+        0.3167995880337834,-0.1016447992989946,0.0564659111447372,-0.0358691598132244,
+        0.0237768348785383,-0.0158343968673330,0.0103629636643361,-0.0065520829753140,
+        0.0039331690731590,-0.0021917215883407,0.0010930312222830,-0.0005076271599221
+    };
+};
+
+template<>
+struct halfband_coeffs<1>
+{
+    /* Stage 2x -> 4x: 15 taps, ~86dB stopband attenuation */
+    constexpr static std::array<float, 4> g
+    {
+        0.3035077151468475,-0.0683709757551957,0.0174704485044157,-0.0026314074101756
+    };
+};
+
+/* Polyphase x2 half-band interpolator (zero taps are skipped, odd outputs are delayed input samples) */
+template<uint32_t taps, uint32_t block_size>
+class halfband_interpolator
 {
 public:
-    averaging_filter(float time_constant, float time_delta, float inital_value = 0)
+    halfband_interpolator(const std::array<float, taps> &g) : g{g}
     {
-        this->alpha1 = 1 - std::exp(-time_delta / time_constant);
-        this->alpha2 = 1 - this->alpha1;
-        this->output = inital_value;
+        this->reset();
     }
-    virtual ~averaging_filter() = default;
 
-    float process(float in)
+    void reset(void)
     {
-        return output = this->alpha2 * output + this->alpha1 * in;
+        this->buffer.fill(0);
     }
 
-    void reset(float value)
+    /* len (up to block_size) samples in, 2 * len samples out (in & out may overlap) */
+    void process(const float *in, float *out, uint32_t len)
     {
-        this->output = value;
-    }
-private:
-    float alpha1, alpha2;
-    float output;
-};
+        float *x = this->buffer.data() + history;
+        std::copy(in, in + len, x);
 
-//-----------------------------------------------------------------------------
+        for (uint32_t n = 0; n < len; n++)
+        {
+            /* Symmetric taps around center x[n - taps + 0.5] */
+            const float *a = x + n - (taps - 1);
+            const float *b = x + n - taps;
+            const float center = *a;
 
-/* Short 3-point median filter */
-class median_filter
-{
-public:
-    median_filter(float median = 0.0f) : median{median}, x2{median}, x3{median} {};
+            float acc = 0;
+            for (uint32_t k = 0; k < taps; k++)
+                acc += this->g[k] * (*a++ + *b--);
 
-    float process(float x1)
+            out[2 * n] = 2 * acc;
+            out[2 * n + 1] = center;
+        }
+
+        std::copy(x + len - history, x + len, this->buffer.data());
+    }
+
+    /* Group delay in input samples */
+    constexpr static float latency(void)
     {
-        median = std::max(std::min(x1, x2), std::min(std::max(x1, x2), x3));
-        x3 = x2;
-        x2 = x1;
-        return median;
+        return (2 * taps - 1) / 2.0f;
     }
 
 private:
-    float median, x2, x3;
-};
-
-//-----------------------------------------------------------------------------
+    constexpr static uint32_t history = 2 * taps;
 
-enum class basic_iir_type {allpass, lowpass, highpass};
+    const std::array<float, taps> &g;
+    std::array<float, history + block_size> buffer;
+};
 
-template<basic_iir_type type>
-class basic_iir
+/* Polyphase x2 half-band decimator (zero taps are skipped, center tap is applied to odd input samples) */
+template<uint32_t taps, uint32_t block_size>
+class halfband_decimator
 {
 public:
-    basic_iir() : c{0}, h{0} {}
-
-    void calc_coeff(float fc, float fs)
+    halfband_decimator(const std::array<float, taps> &g) : g{g}
     {
-        const float wc = fc / fs;
-        const float k = std::tan(pi * wc);
-        this->c = (k - 1) / (k + 1);
+        this->reset();
     }
 
-    void set_coeff(float c)
+    void reset(void)
     {
-        this->c = c;
+        this->even.fill(0);
+        this->odd.fill(0);
     }
 
-    float process(float in)
+    /* 2 * len samples in, len (up to block_size) samples out (in & out may overlap) */
+    void process(const float *in, float *out, uint32_t len)
     {
-        float out = 0;
-
-        /* Allpass */
-        const float inh = in - this->c * this->h;
-        out = this->c * inh + this->h;
-        this->h = inh;
-
-        if constexpr (type == basic_iir_type::lowpass)
+        float *e = this->even.data() + history;
+        float *o = this->odd.data() + history;
+        for (uint32_t n = 0; n < len; n++)
         {
-            out = 0.5f * (in + out);
+            e[n] = in[2 * n];
+            o[n] = in[2 * n + 1];
         }
-        else if constexpr (type == basic_iir_type::highpass)
+
+        for (uint32_t n = 0; n < len; n++)
         {
-            out = 0.5f * (in - out);
+            const float *a = e + n - (taps - 1);
+            const float *b = e + n - taps;
+
+            float acc = 0.5f * *(o + n - taps);
+            for (uint32_t k = 0; k < taps; k++)
+                acc += this->g[k] * (*a++ + *b--);
+
+            out[n] = acc;
         }
 
-        return out;
+        std::copy(e + len - history, e + len, this->even.data());
+        std::copy(o + len - history, o + len, this->odd.data());
     }
+
+    /* Group delay in output samples */
+    constexpr static float latency(void)
+    {
+        return (2 * taps - 1) / 2.0f;
+    }
+
 private:
-    float c;
-    float h;
-};
+    constexpr static uint32_t history = 2 * taps;
 
-//-----------------------------------------------------------------------------
+    const std::array<float, taps> &g;
+    std::array<float, history + block_size> even, odd;
+};
 
-template<uint8_t biquad_stages>
-class iir_biquad
+/* Cascade of x2 half-band stages, first 'active' stages are used & 'f(samples, n)' processes block at highest rate */
+template<uint8_t stages, uint32_t block_size, uint8_t depth = 0>
+class halfband_cascade
 {
 public:
-    iir_biquad()
+    template<typename F>
+    void process(const float *in, float *out, uint32_t len, uint8_t active, F &&f)
     {
-        arm_biquad_cascade_df2T_init_f32
-        (
-            &this->instance,
-            biquad_stages,
-            this->coeffs.data(),
-            this->state.data()
-        );
+        if (active == 0)
+        {
+            if (in != out)
+                std::copy(in, in + len, out);
+            f(out, len);
+            return;
+        }
+
+        this->up.process(in, this->buffer.data(), len);
+        this->next.process(this->buffer.data(), this->buffer.data(), 2 * len, active - 1, f);
+        this->down.process(this->buffer.data(), out, len);
     }
 
-    void set_coeffs(const std::array<float, 5 * biquad_stages> &coeffs)
+    void reset(void)
     {
-        this->coeffs = coeffs;
+        this->up.reset();
+        this->down.reset();
+        this->next.reset();
     }
 
-    void process(const float *in, float *out, uint32_t samples)
+    /* Latency of 'active' stages in samples at rate of this stage's input */
+    float latency(uint8_t active) const
     {
-        arm_biquad_cascade_df2T_f32(&this->instance, const_cast<float*>(in), out, samples);
+        if (active == 0)
+            return 0;
+
+        return this->up.latency() + this->down.latency() + this->next.latency(active - 1) / 2;
     }
-protected:
-    arm_biquad_cascade_df2T_instance_f32 instance;
-    std::array<float, 2 * biquad_stages> state;
-    std::array<float, 5 * biquad_stages> coeffs;
+
+private:
+    constexpr static auto &g = halfband_coeffs<depth>::g;
+
+    halfband_interpolator<g.size(), block_size> up {g};
+    halfband_decimator<g.size(), block_size> down {g};
+    std::array<float, 2 * block_size> buffer;
+    halfband_cascade<stages - 1, 2 * block_size, depth + 1> next;
 };
 
-class iir_lowpass : public iir_biquad<1>
+template<uint32_t block_size, uint8_t depth>
+class halfband_cascade<0, block_size, depth>
 {
 public:
-    void calc_coeffs(float fc, float fs, bool first_order = false)
+    template<typename F>
+    void process(const float *in, float *out, uint32_t len, uint8_t active, F &&f)
     {
-        const float wc = fc / fs;
-        const float k = std::tan(pi * wc);
-        const float q = 1.0f / std::sqrt(2.0f);
+        if (in != out)
+            std::copy(in, in + len, out);
+        f(out, len);
+    }
+
+    void reset(void) {}
+
+    float latency(uint8_t active) const
+    {
+        return 0;
+    }
+};
+
+/*
+ * Oversampling by cascade of polyphase half-band stages (x2 each). Factor can be changed at runtime (up to max_factor),
+ * e.g. to trade quality for CPU load. Nonlinear processing is passed as 'f(float *samples, uint32_t n)'
+ * and works in-place at oversampled rate.
+ */
+template<uint8_t max_factor, uint32_t block_size>
+class oversampler
+{
+public:
+    oversampler(uint8_t factor = max_factor)
+    {
+        this->set_factor(factor);
+    }
+
+    /* Sets oversampling factor (1, 2, 4, ... max_factor), resets filters state */
+    void set_factor(uint8_t factor)
+    {
+        assert(factor > 0 && factor <= max_factor && (factor & (factor - 1)) == 0);
+
+        this->factor = factor;
+        this->active = 0;
+        while ((1U << this->active) < factor)
+            this->active++;
+
+        this->cascade.reset();
+    }
+
+    uint8_t get_factor(void) const
+    {
+        return this->factor;
+    }
+
+    /* Latency (interpolation + decimation) in samples at base rate */
+    float get_latency(void) const
+    {
+        return this->cascade.latency(this->active);
+    }
+
+    /* len (up to block_size) samples in & out, 'f' is called with factor * len samples */
+    template<typename F>
+    void process(const float *in, float *out, uint32_t len, F &&f)
+    {
+        assert(len <= block_size);
+        this->cascade.process(in, out, len, this->active, f);
+    }
+
+private:
+    constexpr static uint8_t stages(uint8_t f)
+    {
+        return f > 1 ? 1 + stages(f / 2) : 0;
+    }
+
+    halfband_cascade<stages(max_factor), block_size> cascade;
+    uint8_t factor;
+    uint8_t active;
+
+    static_assert(max_factor > 0 && (max_factor & (max_factor - 1)) == 0);
+};
+
+//-----------------------------------------------------------------------------
+
+/*
+ * Memoryless monotonic waveshapers with closed-form antiderivatives (F1 - 1st, F2 - 2nd) for antiderivative
+ * anti-aliasing.
+ */
+
+/* Piecewise quadratic hard clipper (Schetzen formula), saturates at |x| > 2/3 */
+struct hard_clip_shaper
+{
+    static float f(float x)
+    {
+        const float u = std::abs(x);
+        if (u < 1.0f / 3) return 2 * x;
+        if (u > 2.0f / 3) return sgn(x);
+        const float v = 2 - 3 * u;
+        return sgn(x) * (3 - v * v) / 3;
+    }
+
+    static float F1(float x)
+    {
+        const float u = std::abs(x);
+        if (u < 1.0f / 3) return x * x;
+        const float v = std::max(2 - 3 * u, 0.0f);
+        return u + v * v * v / 27 - 7.0f / 27;
+    }
+
+    static float F2(float x)
+    {
+        const float u = std::abs(x);
+        if (u < 1.0f / 3) return x * x * x / 3;
+        const float v = std::max(2 - 3 * u, 0.0f);
+        return sgn(x) * (u * u / 2 - v * v * v * v / 324 - 7 * u / 27 + 5.0f / 108);
+    }
+};
+
+/* Exponential soft clipper: sgn(x) * (1 - e^-|x|) */
+struct soft_clip_shaper
+{
+    static float f(float x)
+    {
+        return sgn(x) * (1 - std::exp(-std::abs(x)));
+    }
+
+    static float F1(float x)
+    {
+        const float u = std::abs(x);
+        return u + std::exp(-u) - 1;
+    }
+
+    static float F2(float x)
+    {
+        const float u = std::abs(x);
+        return sgn(x) * (u * u / 2 - u + 1 - std::exp(-u));
+    }
+};
+
+/* Hyperbolic tangent (F2 uses polynomial approximation of dilogarithm, max abs. error 2.5e-7) */
+struct tanh_shaper
+{
+    static float f(float x)
+    {
+        return std::tanh(x);
+    }
+
+    static float F1(float x)
+    {
+        /* log(cosh(x)) without overflow */
+        const float u = std::abs(x);
+        return u + std::log1p(std::exp(-2 * u)) - ln2;
+    }
+
+    static float F2(float x)
+    {
+        const float u = std::abs(x);
+        return sgn(x) * (u * u / 2 - u * ln2 + 0.5f * (li2_neg(std::exp(-2 * u)) - li2_neg(1)));
+    }
+
+private:
+    constexpr static float ln2 {0.6931471805599453};
+
+    /* Li2(-w) for w in [0, 1], minimax polynomial */
+    static float li2_neg(float w)
+    {
+        constexpr float c[] {-2.4624683e-07f, -0.999973701f, 0.249538351f, -0.108003809f, 0.052053194f, -0.0200544857f, 0.00397390988f};
+        float y = c[6];
+        for (int i = 5; i >= 0; i--)
+            y = y * w + c[i];
+        return y;
+    }
+};
+
+/* Arctangent */
+struct atan_shaper
+{
+    static float f(float x)
+    {
+        return std::atan(x);
+    }
+
+    static float F1(float x)
+    {
+        return x * std::atan(x) - 0.5f * std::log1p(x * x);
+    }
+
+    static float F2(float x)
+    {
+        return 0.5f * (x * x - 1) * std::atan(x) - 0.5f * x * std::log1p(x * x) + 0.5f * x;
+    }
+};
+
+/*
+ * Antiderivative anti-aliasing (1-st or 2-nd order) of memoryless waveshaper. Adds delay of order/2 samples,
+ * 'dry()' returns input passed through the same kernel (for aligned dry/wet mixing).
+ */
+template<typename shaper, uint8_t order>
+class adaa
+{
+public:
+    adaa()
+    {
+        this->reset();
+    }
+
+    void reset(void)
+    {
+        this->x1 = this->x2 = this->dry_out = 0;
+        this->F1_x1 = shaper::F1(0);
+        this->F2_x1 = shaper::F2(0);
+        this->D_x1 = shaper::F1(0);
+        this->f_x1 = this->f_x2 = shaper::f(0);
+    }
+
+    float process(float x)
+    {
+        float y;
+
+        if constexpr (order == 1)
+        {
+            /* F1 grows as |x|, so its rounding error is amplified by divided difference at high drive as well */
+            const float F1_x = shaper::F1(x);
+            const float dx = x - this->x1;
+            y = (std::abs(dx) > tolerance_of(x, this->x1)) ? (F1_x - this->F1_x1) / dx : shaper::f(0.5f * (x + this->x1));
+
+            this->F1_x1 = F1_x;
+        }
+        else
+        {
+            /*
+             * D(x, x1) = (F2(x) - F2(x1)) / (x - x1). F2 grows as x^2, so its rounding error (relative to F2) is
+             * amplified by both divided differences: tolerance is relative to magnitude of inputs.
+             */
+            const float F2_x = shaper::F2(x);
+            const float dx = x - this->x1;
+            const float D_x = (std::abs(dx) > tolerance_of(x, this->x1)) ? (F2_x - this->F2_x1) / dx : shaper::F1(0.5f * (x + this->x1));
+
+            const float dx2 = x - this->x2;
+            if (std::abs(dx2) > tolerance_of(x, this->x2))
+            {
+                y = 2 * (D_x - this->D_x1) / dx2;
+            }
+            else
+            {
+                /* Ill-conditioned case (x ~ x2) */
+                const float xb = 0.5f * (x + this->x2);
+                const float delta = xb - this->x1;
+                if (std::abs(delta) > tolerance_of(xb, this->x1))
+                    y = 2 / delta * (shaper::F1(xb) + (this->F2_x1 - shaper::F2(xb)) / delta);
+                else
+                    y = shaper::f(0.5f * (xb + this->x1));
+            }
+
+            /* Kernel averages monotonic shaper between inputs, so result can't leave range of f at them */
+            const float f_x = shaper::f(x);
+            y = std::clamp(y, std::min({f_x, this->f_x1, this->f_x2}), std::max({f_x, this->f_x1, this->f_x2}));
+
+            this->f_x2 = this->f_x1;
+            this->f_x1 = f_x;
+
+            this->F2_x1 = F2_x;
+            this->D_x1 = D_x;
+        }
+
+        /* ADAA of identity is moving average of order + 1 inputs */
+        if constexpr (order == 1)
+            this->dry_out = 0.5f * (x + this->x1);
+        else
+            this->dry_out = (x + this->x1 + this->x2) / 3;
+
+        this->x2 = this->x1;
+        this->x1 = x;
+
+        return y;
+    }
+
+    /* Last input processed by linear kernel of the same order */
+    float dry(void) const
+    {
+        return this->dry_out;
+    }
+
+    /* Delay in samples */
+    constexpr static float latency(void)
+    {
+        return order / 2.0f;
+    }
+
+private:
+    /*
+     * Antiderivatives are evaluated with float precision, differences smaller than ~1% of inputs are ill-conditioned.
+     * 2-nd order: F2 of small inputs loses precision by cancellation & rounding is divided by product of differences,
+     * so absolute tolerance is larger (midpoint fallback error grows only with square of difference).
+     */
+    constexpr static float tolerance {order == 1 ? 1e-3f : 1e-2f};
+    constexpr static float relative_tolerance {1e-2f};
+
+    static float tolerance_of(float a, float b)
+    {
+        return std::max(tolerance, relative_tolerance * std::max(std::abs(a), std::abs(b)));
+    }
+
+    float x1, x2, dry_out;
+    float F1_x1, F2_x1, D_x1;
+    float f_x1, f_x2;
+
+    static_assert(order == 1 || order == 2);
+};
+
+//-----------------------------------------------------------------------------
+
+/* Exponential moving average filter */
+class averaging_filter
+{
+public:
+    averaging_filter(float time_constant, float time_delta, float inital_value = 0)
+    {
+        this->alpha1 = 1 - std::exp(-time_delta / time_constant);
+        this->alpha2 = 1 - this->alpha1;
+        this->output = inital_value;
+    }
+    virtual ~averaging_filter() = default;
+
+    float process(float in)
+    {
+        return output = this->alpha2 * output + this->alpha1 * in;
+    }
+
+    void reset(float value)
+    {
+        this->output = value;
+    }
+private:
+    float alpha1, alpha2;
+    float output;
+};
+
+//-----------------------------------------------------------------------------
+
+/* Short 3-point median filter */
+class median_filter
+{
+public:
+    median_filter(float median = 0.0f) : median{median}, x2{median}, x3{median} {};
+
+    float process(float x1)
+    {
+        median = std::max(std::min(x1, x2), std::min(std::max(x1, x2), x3));
+        x3 = x2;
+        x2 = x1;
+        return median;
+    }
+
+private:
+    float median, x2, x3;
+};
+
+//-----------------------------------------------------------------------------
+
+enum class basic_iir_type {allpass, lowpass, highpass};
+
+template<basic_iir_type type>
+class basic_iir
+{
+public:
+    basic_iir() : c{0}, h{0} {}
+
+    void calc_coeff(float fc, float fs)
+    {
+        const float wc = fc / fs;
+        const float k = std::tan(pi * wc);
+        this->c = (k - 1) / (k + 1);
+    }
+
+    void set_coeff(float c)
+    {
+        this->c = c;
+    }
+
+    float process(float in)
+    {
+        float out = 0;
+
+        /* Allpass */
+        const float inh = in - this->c * this->h;
+        out = this->c * inh + this->h;
+        this->h = inh;
+
+        if constexpr (type == basic_iir_type::lowpass)
+        {
+            out = 0.5f * (in + out);
+        }
+        else if constexpr (type == basic_iir_type::highpass)
+        {
+            out = 0.5f * (in - out);
+        }
+
+        return out;
+    }
+
+    void process(const float *in, float *out, uint32_t n)
+    {
+        const float c = this->c;
+        float h = this->h;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const float x = in[i];
+            const float inh = x - c * h;
+            float y = c * inh + h;
+            h = inh;
+
+            if constexpr (type == basic_iir_type::lowpass)
+                y = 0.5f * (x + y);
+            else if constexpr (type == basic_iir_type::highpass)
+                y = 0.5f * (x - y);
+
+            out[i] = y;
+        }
+
+        this->h = h;
+    }
+private:
+    float c;
+    float h;
+};
+
+//-----------------------------------------------------------------------------
+
+template<uint8_t biquad_stages>
+class iir_biquad
+{
+public:
+    iir_biquad()
+    {
+        arm_biquad_cascade_df2T_init_f32
+        (
+            &this->instance,
+            biquad_stages,
+            this->coeffs.data(),
+            this->state.data()
+        );
+    }
+
+    void set_coeffs(const std::array<float, 5 * biquad_stages> &coeffs)
+    {
+        this->coeffs = coeffs;
+    }
+
+    void process(const float *in, float *out, uint32_t samples)
+    {
+        arm_biquad_cascade_df2T_f32(&this->instance, const_cast<float*>(in), out, samples);
+    }
+protected:
+    arm_biquad_cascade_df2T_instance_f32 instance;
+    std::array<float, 2 * biquad_stages> state;
+    std::array<float, 5 * biquad_stages> coeffs;
+};
+
+/*
+ * Bank of independent biquad cascades (DF2T, coefficients as in 'iir_biquad').
+ * Coefficients & state are stored in SoA layout, so all bands are advanced per input sample in tight loops.
+ */
+template<uint32_t bands, uint8_t biquad_stages>
+class iir_filterbank
+{
+public:
+    iir_filterbank() : coeffs {}
+    {
+        /* Passthrough until coefficients are set */
+        for (auto &&c : this->coeffs)
+            c.b0.fill(1);
+
+        this->reset();
+    }
+
+    void set_coeffs(uint32_t band, const std::array<float, 5 * biquad_stages> &coeffs)
+    {
+        for (uint8_t s = 0; s < biquad_stages; s++)
+        {
+            this->coeffs[s].b0[band] = coeffs[5 * s + 0];
+            this->coeffs[s].b1[band] = coeffs[5 * s + 1];
+            this->coeffs[s].b2[band] = coeffs[5 * s + 2];
+            this->coeffs[s].a1[band] = coeffs[5 * s + 3];
+            this->coeffs[s].a2[band] = coeffs[5 * s + 4];
+        }
+    }
+
+    void reset(void)
+    {
+        for (auto &&st : this->state)
+        {
+            st.d1.fill(0);
+            st.d2.fill(0);
+        }
+    }
+
+    /* Filters one sample common to all bands, output has one sample per band */
+    void process(float in, float *out)
+    {
+        std::fill(out, out + bands, in);
+        this->process(out, out);
+    }
+
+    /* Filters one sample per band (in & out may be the same buffer) */
+    void process(const float *in, float *out)
+    {
+        for (uint8_t s = 0; s < biquad_stages; s++)
+        {
+            const auto &c = this->coeffs[s];
+            auto &st = this->state[s];
+
+            for (uint32_t b = 0; b < bands; b++)
+            {
+                const float x = in[b];
+                const float y = c.b0[b] * x + st.d1[b];
+                st.d1[b] = c.b1[b] * x + c.a1[b] * y + st.d2[b];
+                st.d2[b] = c.b2[b] * x + c.a2[b] * y;
+                out[b] = y;
+            }
+
+            in = out;
+        }
+    }
+
+private:
+    struct stage_coeffs
+    {
+        std::array<float, bands> b0, b1, b2, a1, a2;
+    };
+
+    struct stage_state
+    {
+        std::array<float, bands> d1, d2;
+    };
+
+    std::array<stage_coeffs, biquad_stages> coeffs;
+    std::array<stage_state, biquad_stages> state;
+};
+
+class iir_lowpass : public iir_biquad<1>
+{
+public:
+    void calc_coeffs(float fc, float fs, bool first_order = false)
+    {
+        const float wc = fc / fs;
+        const float k = std::tan(pi * wc);
+        const float q = 1.0f / std::sqrt(2.0f);
 
         const float k2q = k * k * q;
 
@@ -680,6 +1599,10 @@ public:
         /* Multiplication (circular convolution) in frequency domain */
         arm_cmplx_mult_cmplx_f32(this->ir_fft.data() + this->fft_size, this->input_fft.data() + this->fft_size, this->input_fft.data(), this->fft_size / 2);
 
+        /* First complex value holds real DC & Nyquist bins (CMSIS RFFT packing) */
+        this->input_fft[0] = this->ir_fft[this->fft_size + 0] * this->input_fft[this->fft_size + 0];
+        this->input_fft[1] = this->ir_fft[this->fft_size + 1] * this->input_fft[this->fft_size + 1];
+
         /* Inverse FFT */
         arm_rfft_fast_f32(&this->fft, this->input_fft.data(), this->input_fft.data() + this->fft_size, 1);
 
@@ -700,6 +1623,455 @@ private:
     std::array<float, fft_size> input;
 };
 
+/*
+ * Adapts blocks of any size to fixed processing block (e.g. FFT frame). Blocks being multiple of block_size are
+ * processed directly, other sizes go through FIFOs & are delayed by block_size samples.
+ * 'f(const std::array<const float*, inputs> &in, float *out)' processes exactly block_size samples.
+ */
+template<uint32_t block_size, uint8_t inputs = 1>
+class fixed_block_adapter
+{
+public:
+    using block_inputs = std::array<const float*, inputs>;
+
+    fixed_block_adapter()
+    {
+        this->reset();
+    }
+
+    void reset(void)
+    {
+        for (auto &fifo : this->in_fifo)
+            fifo.fill(0);
+        this->out_fifo.fill(0);
+        this->pos = 0;
+        this->buffered = false;
+    }
+
+    template<typename F>
+    void process(const block_inputs &in, float *out, uint32_t len, F &&f)
+    {
+        this->process_blocks(in, out, len, f);
+    }
+
+    template<typename F>
+    void process(const float *in, float *out, uint32_t len, F &&f)
+    {
+        this->process_blocks({in}, out, len, f);
+    }
+
+    /* Analysis only (no output), 'f(const std::array<const float*, inputs> &in)' */
+    template<typename F>
+    void process(const block_inputs &in, uint32_t len, F &&f)
+    {
+        this->process_blocks(in, nullptr, len, [&f](const block_inputs &blk, float *out) { f(blk); });
+    }
+
+    template<typename F>
+    void process(const float *in, uint32_t len, F &&f)
+    {
+        this->process(block_inputs {in}, len, f);
+    }
+
+    /* Delay added for blocks of given size */
+    constexpr static uint32_t latency(uint32_t len)
+    {
+        return (len % block_size) ? block_size : 0;
+    }
+
+private:
+    template<typename F>
+    void process_blocks(const block_inputs &in, float *out, uint32_t len, F &&f)
+    {
+        if (latency(len) == 0)
+        {
+            /* Switching from buffered mode drops FIFOs content */
+            if (this->buffered)
+                this->reset();
+
+            for (uint32_t i = 0; i < len; i += block_size)
+            {
+                block_inputs blk;
+                for (uint8_t ch = 0; ch < inputs; ch++)
+                    blk[ch] = in[ch] + i;
+
+                f(blk, out ? out + i : nullptr);
+            }
+            return;
+        }
+
+        this->buffered = true;
+
+        block_inputs blk;
+        for (uint8_t ch = 0; ch < inputs; ch++)
+            blk[ch] = this->in_fifo[ch].data();
+
+        for (uint32_t i = 0; i < len;)
+        {
+            const uint32_t chunk = std::min(len - i, block_size - this->pos);
+
+            /* Input is copied before output is written, so in & out may overlap */
+            for (uint8_t ch = 0; ch < inputs; ch++)
+                std::copy(in[ch] + i, in[ch] + i + chunk, this->in_fifo[ch].data() + this->pos);
+
+            if (out)
+                std::copy(this->out_fifo.data() + this->pos, this->out_fifo.data() + this->pos + chunk, out + i);
+
+            this->pos += chunk;
+            i += chunk;
+
+            if (this->pos == block_size)
+            {
+                f(blk, this->out_fifo.data());
+                this->pos = 0;
+            }
+        }
+    }
+
+    std::array<std::array<float, block_size>, inputs> in_fifo;
+    std::array<float, block_size> out_fifo;
+    uint32_t pos;
+    bool buffered;
+};
+
+/* Uniformly-partitioned overlap-save convolution (cost per block does not depend on FFT of whole IR) */
+template<uint16_t block_size, uint32_t ir_size>
+class partitioned_convolution
+{
+public:
+    partitioned_convolution()
+    {
+        arm_rfft_fast_init_f32(&this->fft, this->fft_size);
+        arm_fill_f32(0, this->ir_fdl.data(), this->ir_fdl.size());
+        arm_fill_f32(0, this->input_fdl.data(), this->input_fdl.size());
+        arm_fill_f32(0, this->input.data(), this->input.size());
+        this->fdl_idx = 0;
+        this->active_partitions = partitions;
+    }
+
+    /* Use only first part of IR (rounded up to partitions), lowers cost of convolution */
+    void set_length(uint32_t samples)
+    {
+        this->active_partitions = std::clamp<uint32_t>((samples + block_size - 1) / block_size, 1, partitions);
+    }
+
+    uint32_t get_length(void) const
+    {
+        return this->active_partitions * block_size;
+    }
+
+    void set_ir(const float *ir)
+    {
+        /* Precompute FFT of each IR partition (zero padded to 2 * block_size) */
+        for (uint32_t p = 0; p < partitions; p++)
+        {
+            const uint32_t len = std::min<uint32_t>(block_size, ir_size - p * block_size);
+
+            arm_fill_f32(0, this->buffer.data(), this->buffer.size());
+            arm_copy_f32(const_cast<float*>(ir) + p * block_size, this->buffer.data(), len);
+            arm_rfft_fast_f32(&this->fft, this->buffer.data(), this->ir_fdl.data() + p * fft_size, 0);
+        }
+    }
+
+    void process(const float *in, float *out)
+    {
+        /* Sliding window of two input blocks */
+        arm_copy_f32(this->input.data() + block_size, this->input.data(), block_size);
+        arm_copy_f32(const_cast<float*>(in), this->input.data() + block_size, block_size);
+
+        /* FFT of sliding window is put at the head of frequency-domain delay line */
+        this->fdl_idx = (this->fdl_idx == 0) ? partitions - 1 : this->fdl_idx - 1;
+        arm_copy_f32(this->input.data(), this->buffer.data(), fft_size);
+        arm_rfft_fast_f32(&this->fft, this->buffer.data(), this->input_fdl.data() + this->fdl_idx * fft_size, 0);
+
+        /* Multiply-accumulate each IR partition with input spectrum delayed by partition index */
+        arm_fill_f32(0, this->accumulator.data(), this->accumulator.size());
+        for (uint32_t p = 0, i = this->fdl_idx; p < this->active_partitions; p++)
+        {
+            cmplx_mult_acc(this->input_fdl.data() + i * fft_size, this->ir_fdl.data() + p * fft_size, this->accumulator.data());
+
+            if (++i == partitions)
+                i = 0;
+        }
+
+        /* Inverse FFT, only the last block is free of circular convolution aliasing */
+        arm_rfft_fast_f32(&this->fft, this->accumulator.data(), this->buffer.data(), 1);
+        arm_copy_f32(this->buffer.data() + block_size, out, block_size);
+    }
+private:
+    static void cmplx_mult_acc(const float *a, const float *b, float *acc)
+    {
+        /* First complex value holds real DC & Nyquist bins (CMSIS RFFT packing) */
+        acc[0] += a[0] * b[0];
+        acc[1] += a[1] * b[1];
+
+        for (uint32_t k = 2; k < fft_size; k += 2)
+        {
+            acc[k + 0] += a[k] * b[k] - a[k + 1] * b[k + 1];
+            acc[k + 1] += a[k] * b[k + 1] + a[k + 1] * b[k];
+        }
+    }
+
+    /* Max supported FFT size is 4096 */
+    static_assert((2 * block_size) <= 4096);
+
+    constexpr static uint32_t fft_size {2 * block_size};
+    constexpr static uint32_t partitions {(ir_size + block_size - 1) / block_size};
+
+    arm_rfft_fast_instance_f32 fft;
+    uint32_t fdl_idx;
+    uint32_t active_partitions;
+
+    std::array<float, partitions * fft_size> ir_fdl;
+    std::array<float, partitions * fft_size> input_fdl;
+    std::array<float, fft_size> accumulator;
+    std::array<float, fft_size> buffer;
+    std::array<float, fft_size> input;
+};
+
+/*
+ * Non-uniformly partitioned zero-latency convolution for long impulse responses.
+ * Head of IR is handled by direct FIR, the rest by stages of FFT partitions growing 4x in size
+ * (up to 2048 samples). Stage with partition size P starts at IR offset 2P, so the work of each
+ * large partition can be spread over P/block_size audio blocks. Partition spectra & delay lines
+ * are kept in external memory (e.g. SDRAM) of size 'memory_size' provided by user.
+ *
+ * FFT itself can't be split, so per-block cost is bounded by: direct FIR + for each stage one FFT of 2P
+ * (forward in first step, inverse in last one) + its even share of complex MACs. Periods of all stages
+ * start at the same block, so in the worst block all stages do forward FFT at once (MACs are moved away
+ * from first & last steps to compensate). In-place processing ('in' == 'out') is supported.
+ */
+template<uint16_t block_size, uint32_t ir_size>
+class nonuniform_convolution
+{
+    struct stage_layout
+    {
+        uint32_t partition_size;
+        uint32_t partitions;
+        uint32_t offset;
+    };
+
+    constexpr static uint32_t max_stages {8};
+    constexpr static uint32_t max_partition_size {2048};
+
+    constexpr static std::array<stage_layout, max_stages> calc_layout(void)
+    {
+        std::array<stage_layout, max_stages> layout {};
+
+        /* First stage works with latency of one block, so it starts right after direct FIR */
+        uint32_t offset = block_size;
+        uint32_t size = block_size;
+
+        for (uint32_t s = 0; s < max_stages && offset < ir_size; s++)
+        {
+            const uint32_t next_size = std::min(4 * size, max_partition_size);
+            const bool last = (next_size == size) || (s == max_stages - 1);
+            const uint32_t end = last ? ir_size : std::min(2 * next_size, ir_size);
+
+            layout[s] = {size, (end - offset + size - 1) / size, offset};
+
+            offset = end;
+            size = next_size;
+        }
+
+        return layout;
+    }
+
+    constexpr static uint32_t calc_memory_size(void)
+    {
+        uint32_t size = 0;
+        for (auto &&s : layout)
+            size += s.partitions ? (2 * s.partitions * 2 * s.partition_size + 7 * s.partition_size) : 0;
+        return size;
+    }
+
+    constexpr static uint32_t head_size {std::min<uint32_t>(block_size, ir_size)};
+    constexpr static std::array<stage_layout, max_stages> layout {calc_layout()};
+
+    /* Uniformly partitioned stage, which work is spread over (partition_size / block_size) blocks */
+    class stage
+    {
+    public:
+        void init(const stage_layout &l, float *memory)
+        {
+            this->size = l.partition_size;
+            this->partitions = l.partitions;
+            this->steps = this->size / block_size;
+            this->step = this->steps;
+
+            /* Cost of FFT in quarters of partition's complex MAC (~0.25 * log2(2P) of MAC) */
+            this->fft_cost = 0;
+            for (uint32_t n = 2 * this->size; n > 1; n >>= 1)
+                this->fft_cost++;
+            this->fill = 0;
+            this->fdl_idx = 0;
+
+            this->ir_fdl = memory;
+            this->input_fdl = this->ir_fdl + this->partitions * 2 * this->size;
+            this->window = this->input_fdl + this->partitions * 2 * this->size;
+            this->accumulator = this->window + 2 * this->size;
+            this->buffer = this->accumulator + 2 * this->size;
+            this->output = this->buffer + 2 * this->size;
+
+            arm_rfft_fast_init_f32(&this->fft, 2 * this->size);
+            arm_fill_f32(0, this->input_fdl, (this->output + this->size) - this->input_fdl);
+        }
+
+        void set_ir(const float *ir, uint32_t len)
+        {
+            for (uint32_t p = 0; p < this->partitions; p++)
+            {
+                const uint32_t n = std::min(this->size, len - std::min(len, p * this->size));
+
+                arm_fill_f32(0, this->buffer, 2 * this->size);
+                arm_copy_f32(const_cast<float*>(ir) + p * this->size, this->buffer, n);
+                arm_rfft_fast_f32(&this->fft, this->buffer, this->ir_fdl + p * 2 * this->size, 0);
+            }
+        }
+
+        void process(const float *in, float *out)
+        {
+            /* Add slice of output computed during previous period */
+            arm_add_f32(out, this->output + this->fill * block_size, out, block_size);
+
+            /* Continue work on recently completed input partition */
+            if (this->step < this->steps)
+                this->compute(this->step++);
+
+            /* Collect input */
+            arm_copy_f32(const_cast<float*>(in), this->window + this->size + this->fill * block_size, block_size);
+
+            if (++this->fill == this->steps)
+            {
+                this->fill = 0;
+                this->step = 0;
+
+                /* Stage with one-block partitions computes immediately */
+                if (this->steps == 1)
+                    this->compute(this->step++);
+            }
+        }
+    private:
+        void compute(uint32_t n)
+        {
+            const uint32_t fft_size = 2 * this->size;
+
+            if (n == 0)
+            {
+                /* FFT of sliding window is put at the head of frequency-domain delay line */
+                this->fdl_idx = (this->fdl_idx == 0) ? this->partitions - 1 : this->fdl_idx - 1;
+                arm_copy_f32(this->window, this->buffer, fft_size);
+                arm_rfft_fast_f32(&this->fft, this->buffer, this->input_fdl + this->fdl_idx * fft_size, 0);
+                arm_copy_f32(this->window + this->size, this->window, this->size);
+                arm_fill_f32(0, this->accumulator, fft_size);
+            }
+
+            /* Each step accumulates its share of partitions, so that FFT & MACs are evenly spread over steps */
+            const uint32_t first = this->first_partition(n);
+            const uint32_t last = this->first_partition(n + 1);
+            for (uint32_t p = first; p < last; p++)
+            {
+                uint32_t i = this->fdl_idx + p;
+                if (i >= this->partitions)
+                    i -= this->partitions;
+
+                const float *a = this->input_fdl + i * fft_size;
+                const float *b = this->ir_fdl + p * fft_size;
+
+                /* First complex value holds real DC & Nyquist bins (CMSIS RFFT packing) */
+                this->accumulator[0] += a[0] * b[0];
+                this->accumulator[1] += a[1] * b[1];
+
+                for (uint32_t k = 2; k < fft_size; k += 2)
+                {
+                    this->accumulator[k + 0] += a[k] * b[k] - a[k + 1] * b[k + 1];
+                    this->accumulator[k + 1] += a[k] * b[k + 1] + a[k + 1] * b[k];
+                }
+            }
+
+            if (n == this->steps - 1)
+            {
+                /* Inverse FFT, only the last partition is free of circular convolution aliasing */
+                arm_rfft_fast_f32(&this->fft, this->accumulator, this->buffer, 1);
+                arm_copy_f32(this->buffer + this->size, this->output, this->size);
+            }
+        }
+
+        uint32_t first_partition(uint32_t n) const
+        {
+            /*
+             * Work of period in quarters of partition's MAC: forward FFT, 4 per partition, inverse FFT.
+             * Step gets partitions, which start within its even share of work.
+             */
+            const uint32_t work = 4 * this->partitions + 2 * this->fft_cost;
+            const uint32_t start = n * work / this->steps;
+            if (start <= this->fft_cost)
+                return 0;
+
+            return std::min((start - this->fft_cost + 3) / 4, this->partitions);
+        }
+
+        arm_rfft_fast_instance_f32 fft;
+        uint32_t size, partitions, steps, step, fill, fdl_idx, fft_cost;
+        float *ir_fdl, *input_fdl, *window, *accumulator, *buffer, *output;
+    };
+
+public:
+    /* Required size (in samples) of external memory */
+    constexpr static uint32_t memory_size {calc_memory_size()};
+
+    nonuniform_convolution(float *memory)
+    {
+        for (uint32_t s = 0; s < max_stages; s++)
+        {
+            if (layout[s].partitions == 0)
+                break;
+
+            this->stages[s].init(layout[s], memory);
+            memory += 2 * layout[s].partitions * 2 * layout[s].partition_size + 7 * layout[s].partition_size;
+            this->stages_count = s + 1;
+        }
+
+        arm_fill_f32(0, this->head_coeffs.data(), this->head_coeffs.size());
+        arm_fir_init_f32(&this->head, head_size, this->head_coeffs.data(), this->head_state.data(), block_size);
+    }
+
+    void set_ir(const float *ir)
+    {
+        /* Direct FIR coefficients are stored in time reversed order */
+        std::reverse_copy(ir, ir + head_size, this->head_coeffs.begin());
+
+        for (uint32_t s = 0; s < this->stages_count; s++)
+            this->stages[s].set_ir(ir + layout[s].offset, ir_size - layout[s].offset);
+    }
+
+    void process(const float *in, float *out)
+    {
+        /* Stages read input after head has written output, so in-place processing works on copy of input */
+        if (in == out)
+        {
+            arm_copy_f32(const_cast<float*>(in), this->input.data(), block_size);
+            in = this->input.data();
+        }
+
+        /* Zero-latency head */
+        arm_fir_f32(&this->head, const_cast<float*>(in), out, block_size);
+
+        for (uint32_t s = 0; s < this->stages_count; s++)
+            this->stages[s].process(in, out);
+    }
+private:
+    static_assert(max_partition_size % block_size == 0);
+
+    arm_fir_instance_f32 head;
+    std::array<float, head_size> head_coeffs;
+    std::array<float, block_size + head_size - 1> head_state;
+    std::array<float, block_size> input;
+
+    std::array<stage, max_stages> stages;
+    uint32_t stages_count {0};
+};
+
 //-----------------------------------------------------------------------------
 
 /* Universal comb filter with optional lowpass filter, delay tap, delay modulation & interpolation */
@@ -743,11 +2115,20 @@ public:
         this->lowpass.calc_coeff(fc, this->fs);
     }
 
+    float get_blend(void) const { return this->bl; }
+    float get_feedback(void) const { return this->fb; }
+    float get_feedforward(void) const { return this->ff; }
+
     float at(uint32_t d)
     {
         return this->delay.at(d);
     }
 
+    void read(float *out, uint32_t n, uint32_t d)
+    {
+        this->delay.read(out, n, d);
+    }
+
     void normalize(void)
     {
         /* L2 normalization (in case when unicomb acts as IIR, needs update after coeffs change) */
@@ -767,7 +2148,82 @@ public:
         return this->ff * del + this->bl * h;
     }
 
+    template<bool lowpass_enabled = false, bool intrpl_enabled = false, uint32_t delay_tap = 0>
+    void process(const float *in, float *out, uint32_t n)
+    {
+        /* Block is processed in chunks not longer than delay, so each chunk depends only on already written samples */
+        constexpr uint32_t max_chunk = 64;
+        std::array<float, max_chunk> del, tap;
+
+        uint32_t max_len = std::min(max_chunk, this->delay.get_delay());
+        if constexpr (delay_tap > 0) max_len = std::min(max_len, delay_tap);
+
+        while (n > 0)
+        {
+            const uint32_t len = std::min(n, max_len);
+
+            this->delay.template read<intrpl_enabled>(del.data(), len);
+            this->process_chunk<lowpass_enabled, delay_tap>(in, del.data(), tap.data(), out, len);
+
+            in += len;
+            out += len;
+            n -= len;
+        }
+    }
+
+    /* Block processing with modulated delay (per-sample delay in samples, linear or allpass interpolation) */
+    template<bool lowpass_enabled = false, bool allpass_intrpl = false, uint32_t delay_tap = 0>
+    void process(const float *in, float *out, const float *delays, uint32_t n)
+    {
+        constexpr uint32_t max_chunk = 64;
+        std::array<float, max_chunk> del, tap;
+
+        /* Chunk must not be longer than the shortest delay in block */
+        uint32_t max_len = std::min<uint32_t>(max_chunk, std::max(1.0f, *std::min_element(delays, delays + n)));
+        if constexpr (delay_tap > 0) max_len = std::min(max_len, delay_tap);
+
+        while (n > 0)
+        {
+            const uint32_t len = std::min(n, max_len);
+
+            this->delay.template read<allpass_intrpl>(del.data(), delays, len);
+            this->process_chunk<lowpass_enabled, delay_tap>(in, del.data(), tap.data(), out, len);
+
+            in += len;
+            out += len;
+            delays += len;
+            n -= len;
+        }
+    }
+
 private:
+    /* Processes chunk for which delay output 'del' was already read, 'tap' is used as scratch buffer */
+    template<bool lowpass_enabled, uint32_t delay_tap>
+    void process_chunk(const float *in, float *del, float *tap, float *out, uint32_t len)
+    {
+        const float *t = del;
+        if constexpr (delay_tap > 0)
+        {
+            this->delay.read(tap, len, delay_tap);
+            t = tap;
+        }
+        if constexpr (lowpass_enabled)
+        {
+            this->lowpass.process(t, tap, len);
+            t = tap;
+        }
+
+        /* h = in + fb * tap */
+        arm_scale_f32(const_cast<float*>(t), this->fb, tap, len);
+        arm_add_f32(const_cast<float*>(in), tap, tap, len);
+        this->delay.write(tap, len);
+
+        /* out = ff * del + bl * h */
+        arm_scale_f32(del, this->ff, del, len);
+        arm_scale_f32(tap, this->bl, tap, len);
+        arm_add_f32(del, tap, out, len);
+    }
+
     const uint32_t fs;
 
     float bl, fb, ff;
@@ -0,0 +1,120 @@
+/*
+ * cycle_stats.hpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef CYCLE_STATS_HPP_
+#define CYCLE_STATS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <limits>
+#include <algorithm>
+
+namespace libs
+{
+
+/*
+ * Execution time statistics (in CPU cycles) with log-bucketed histogram for percentile estimation.
+ * Each octave is split into 4 linear sub-buckets, so percentiles are accurate to ~25% of value
+ * (reported as upper edge of bucket, limited by max observed value). Samples below 256 cycles share
+ * the first bucket, samples above 2^29 cycles share the last one. Not thread safe.
+ */
+class cycle_stats
+{
+public:
+    cycle_stats() { this->reset(); }
+
+    void reset(void)
+    {
+        this->count = 0;
+        this->sum = 0;
+        this->min_cycles = std::numeric_limits<uint32_t>::max();
+        this->max_cycles = 0;
+        this->deadline_misses = 0;
+        this->histogram.fill(0);
+    }
+
+    void add(uint32_t cycles)
+    {
+        this->count++;
+        this->sum += cycles;
+        if (cycles < this->min_cycles)
+            this->min_cycles = cycles;
+        if (cycles > this->max_cycles)
+            this->max_cycles = cycles;
+
+        this->histogram[bucket(cycles)]++;
+    }
+
+    /* Count block in which measured code took part and deadline was missed */
+    void add_deadline_miss(void) { this->deadline_misses++; }
+
+    uint32_t samples(void) const { return this->count; }
+    uint32_t misses(void) const { return this->deadline_misses; }
+    uint32_t min(void) const { return this->count ? this->min_cycles : 0; }
+    uint32_t max(void) const { return this->max_cycles; }
+    uint32_t avg(void) const { return this->count ? this->sum / this->count : 0; }
+
+    /* Estimated percentile, p in range (0, 1), e.g. 0.99 for p99 */
+    uint32_t percentile(float p) const
+    {
+        if (this->count == 0)
+            return 0;
+
+        /* Rank of sample (rounded up) */
+        const float rank = p * this->count;
+        uint64_t target = static_cast<uint64_t>(rank);
+        if (target < rank || target == 0)
+            target++;
+
+        uint64_t acc = 0;
+        for (size_t i = 0; i < buckets; i++)
+        {
+            acc += this->histogram[i];
+            if (acc >= target)
+                return std::min(bucket_upper_edge(i), this->max_cycles);
+        }
+
+        return this->max_cycles;
+    }
+
+private:
+    static constexpr uint8_t sub_bits = 2;
+    static constexpr uint8_t first_octave = 8;
+    static constexpr uint8_t octaves = 21;
+    static constexpr size_t buckets = octaves << sub_bits;
+
+    static size_t bucket(uint32_t cycles)
+    {
+        if (cycles < (1ul << first_octave))
+            return 0;
+
+        const uint8_t msb = 31 - __builtin_clz(cycles);
+        const uint32_t sub = (cycles >> (msb - sub_bits)) & ((1ul << sub_bits) - 1);
+        const size_t idx = ((msb - first_octave) << sub_bits) | sub;
+        return idx < buckets ? idx : buckets - 1;
+    }
+
+    static uint32_t bucket_upper_edge(size_t idx)
+    {
+        const uint8_t octave = first_octave + (idx >> sub_bits);
+        const uint64_t step = 1ull << (octave - sub_bits);
+        const uint64_t upper = (1ull << octave) + ((idx & ((1ul << sub_bits) - 1)) + 1) * step - 1;
+        return upper > std::numeric_limits<uint32_t>::max() ? std::numeric_limits<uint32_t>::max() : upper;
+    }
+
+    uint32_t count;
+    uint64_t sum;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint32_t deadline_misses;
+    std::array<uint32_t, buckets> histogram;
+};
+
+}
+
+#endif /* CYCLE_STATS_HPP_ */
@@ -0,0 +1,222 @@
+/*
+ * fast_math.hpp
+ *
+ *  Created on: 17 paź 2026
+ *      Author: kwarc
+ */
+
+#ifndef FAST_MATH_HPP_
+#define FAST_MATH_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+/*
+ * Fast single precision approximations of transcendental functions for per-sample DSP code.
+ * Accuracy is selected at compile time, max errors (measured in float32 over given domain) are documented
+ * next to each function. Arguments outside of documented domain are not checked (e.g. log2 of x <= 0).
+ */
+namespace libs::adsp::fastmath
+{
+
+enum class precision { low, high };
+
+namespace detail
+{
+    constexpr inline float pi {3.1415926535897932};
+    constexpr inline float log2e {1.4426950408889634};
+
+    inline float as_float(uint32_t u)
+    {
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+
+    inline uint32_t as_uint(float f)
+    {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    /* Polynomial evaluation (Horner's scheme), coefficients in ascending order */
+    template<size_t n>
+    inline float poly(float x, const float (&c)[n])
+    {
+        float y = c[n - 1];
+        for (size_t i = n - 1; i > 0; i--)
+            y = y * x + c[i - 1];
+        return y;
+    }
+}
+
+/*
+ * 2^x, minimax polynomial of 2^f for f in [0, 1) scaled by exponent, x is clamped to [-126, 128)
+ * - low:  max rel. error 7.5e-5
+ * - high: max rel. error 1.7e-7
+ */
+template<precision p = precision::high>
+inline float exp2(float x)
+{
+    x = std::clamp(x, -126.0f, 127.999f);
+
+    /* Floor without library call */
+    int32_t xi = static_cast<int32_t>(x);
+    if (x < xi)
+        xi--;
+    const float f = x - xi;
+
+    float y;
+    if constexpr (p == precision::low)
+        y = detail::poly(f, {0.999925219f, 0.695833541f, 0.226067155f, 0.0780245227f});
+    else
+        y = detail::poly(f, {0.999999925f, 0.693153073f, 0.240153617f, 0.0558263181f, 0.00898934009f, 0.00187757667f});
+
+    return y * detail::as_float(static_cast<uint32_t>(xi + 127) << 23);
+}
+
+/*
+ * e^x, see exp2()
+ * - low:  max rel. error 7.9e-5
+ * - high: max rel. error 3.9e-6 for |x| < 80 (dominated by rounding of x * log2(e))
+ */
+template<precision p = precision::high>
+inline float exp(float x)
+{
+    return exp2<p>(x * detail::log2e);
+}
+
+/*
+ * log2(x) for x > 0, minimax polynomial in s = (m - 1) / (m + 1), where m is mantissa in [sqrt(2)/2, sqrt(2))
+ * - errors for x in [2^-32, 2^32], beyond rounding of result (in float) dominates
+ * - low:  max abs. error 1.2e-5
+ * - high: max abs. error 1.1e-6 (3.8e-7 for x in [0.01, 100])
+ */
+template<precision p = precision::high>
+inline float log2(float x)
+{
+    uint32_t u = detail::as_uint(x);
+    int32_t e = static_cast<int32_t>(u >> 23) - 127;
+
+    /* Move mantissa to [sqrt(2)/2, sqrt(2)) */
+    u &= 0x007FFFFF;
+    if (u > 0x003504F3)
+    {
+        u |= 0x3F000000;
+        e++;
+    }
+    else
+    {
+        u |= 0x3F800000;
+    }
+
+    const float m = detail::as_float(u);
+    const float s = (m - 1) / (m + 1);
+    const float t = s * s;
+
+    float y;
+    if constexpr (p == precision::low)
+        y = detail::poly(t, {2.88532587f, 0.979128065f});
+    else
+        y = detail::poly(t, {2.88539042f, 0.961588326f, 0.595780723f});
+
+    return e + s * y;
+}
+
+/*
+ * x^y for x > 0, computed as 2^(y * log2(x))
+ * - error grows with |y * log2(x)|, measured for x in [0.01, 100] & y = 2.4:
+ * - low:  max rel. error 9.4e-5
+ * - high: max rel. error 1.4e-6
+ */
+template<precision p = precision::high>
+inline float pow(float x, float y)
+{
+    return exp2<p>(y * log2<p>(x));
+}
+
+/*
+ * tanh(x)
+ * - low:  Padé [7/6] approximant clamped at |x| = 4.97, max abs. error 9.6e-5
+ * - high: 1 - 2 / (e^(2x) + 1), max abs. error 1.6e-7
+ */
+template<precision p = precision::high>
+inline float tanh(float x)
+{
+    if constexpr (p == precision::low)
+    {
+        x = std::clamp(x, -4.97f, 4.97f);
+        const float x2 = x * x;
+        const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return num / den;
+    }
+    else
+    {
+        const float y = 1.0f - 2.0f / (exp2<p>(2.0f * detail::log2e * std::abs(x)) + 1.0f);
+        return std::copysign(y, x);
+    }
+}
+
+/*
+ * atan(x), minimax polynomial x * P(x^2) for |x| <= 1, atan(x) = pi/2 - atan(1/x) otherwise
+ * - low:  max abs. error 1.7e-4
+ * - high: max abs. error 6.1e-7
+ */
+template<precision p = precision::high>
+inline float atan(float x)
+{
+    const float ax = std::abs(x);
+    const bool inv = ax > 1.0f;
+    const float z = inv ? 1.0f / ax : ax;
+    const float t = z * z;
+
+    float y;
+    if constexpr (p == precision::low)
+        y = z * detail::poly(t, {0.999787848f, -0.325808448f, 0.155578753f, -0.0443266137f});
+    else
+        y = z * detail::poly(t, {0.999999348f, -0.333265149f, 0.198814825f, -0.134871915f, 0.083871192f, -0.0370130022f, 0.00786337701f});
+
+    if (inv)
+        y = 0.5f * detail::pi - y;
+
+    return std::copysign(y, x);
+}
+
+/*
+ * tan(x), minimax polynomial x * P(x^2) for |x| <= pi/4, tan(x) = 1/tan(pi/2 - x) for pi/4 < |x| < pi/2
+ * - errors for |x| < 0.45 pi, closer to poles rounding of (pi/2 - x) dominates
+ * - low:  max rel. error 6.2e-4
+ * - high: max rel. error 3.5e-6 (argument reduction adds error for |x| > pi/2)
+ */
+template<precision p = precision::high>
+inline float tan(float x)
+{
+    /* Reduce to [-pi/2, pi/2] */
+    x -= detail::pi * std::round(x * (1.0f / detail::pi));
+
+    const float ax = std::abs(x);
+    const bool inv = ax > 0.25f * detail::pi;
+    const float z = inv ? 0.5f * detail::pi - ax : ax;
+    const float t = z * z;
+
+    float y;
+    if constexpr (p == precision::low)
+        y = z * detail::poly(t, {1.00061491f, 0.315864292f, 0.202364953f});
+    else
+        y = z * detail::poly(t, {1.00000317f, 0.333079804f, 0.136517238f, 0.0403983743f, 0.0438206719f});
+
+    if (inv)
+        y = 1.0f / y;
+
+    return std::copysign(y, x);
+}
+
+}
+
+#endif /* FAST_MATH_HPP_ */
@@ -9,12 +9,17 @@
 #ifndef FAST_QUEUE_HPP_
 #define FAST_QUEUE_HPP_
 
+#include <cstddef>
 #include <array>
+#include <atomic>
 
 namespace libs
 {
 
-/* Single Producer - Single Consumer queue with no locks */
+/*
+ * Single Producer - Single Consumer queue with no locks (wait-free).
+ * push() may be called only from one thread/interrupt and pop() only from one other thread/interrupt.
+ */
 template<typename T, size_t N>
 class fast_queue
 {
@@ -24,12 +29,14 @@ public:
 
     bool empty() const
     {
-        return this->read_idx == this->write_idx;
+        return this->read_idx.load(std::memory_order_acquire) == this->write_idx.load(std::memory_order_acquire);
     }
 
-    constexpr size_t size() const
+    size_t size() const
     {
-        return this->write_idx - this->read_idx;
+        const size_t w = this->write_idx.load(std::memory_order_acquire);
+        const size_t r = this->read_idx.load(std::memory_order_acquire);
+        return (w + storage_size - r) % storage_size;
     }
 
     constexpr size_t max_size() const
@@ -39,28 +46,40 @@ public:
 
     bool push(const T &element)
     {
-        if (this->size() == N)
+        const size_t w = this->write_idx.load(std::memory_order_relaxed);
+        const size_t next = (w + 1) % storage_size;
+
+        /* Full, consumer did not release the slot yet */
+        if (next == this->read_idx.load(std::memory_order_acquire))
             return false;
 
-        this->elements[this->write_idx % N] = element;
-        this->write_idx++;
+        this->elements[w] = element;
+
+        /* Publish element to consumer */
+        this->write_idx.store(next, std::memory_order_release);
         return true;
     }
 
     bool pop(T &element)
     {
-        if (this->empty())
+        const size_t r = this->read_idx.load(std::memory_order_relaxed);
+
+        if (r == this->write_idx.load(std::memory_order_acquire))
             return false;
 
-        element = this->elements[this->read_idx % N];
-        this->read_idx++;
+        element = this->elements[r];
+
+        /* Release slot to producer */
+        this->read_idx.store((r + 1) % storage_size, std::memory_order_release);
         return true;
     }
 
 private:
     /* When read_idx == write_idx queue is empty, so storage should be +1 size */
-    size_t read_idx, write_idx;
-    std::array<T, N + 1> elements;
+    constexpr static size_t storage_size = N + 1;
+
+    std::atomic<size_t> read_idx, write_idx;
+    std::array<T, storage_size> elements;
 };
 
 }
@@ -5,6 +5,53 @@
 
 #include "fxobjects.h"
 
+#include <libs/fast_math.hpp>
+
+// --- opt-in: fast approximations of exp/tanh/atan in per-sample code (see libs/fast_math.hpp for errors)
+#ifndef VALVES_FAST_MATH
+#define VALVES_FAST_MATH 0
+#endif
+
+// --- opt-in: antiderivative anti-aliasing of atan/tanh waveshapers, 0 - disabled, 1 or 2 - order (adds order/2 samples delay)
+#ifndef VALVES_ADAA
+#define VALVES_ADAA 0
+#endif
+
+#if VALVES_ADAA
+#include <libs/audio_dsp.hpp>
+#endif
+
+// --- helpers for per-sample transcendentals (argument type is preserved when fast math is disabled)
+template<typename T>
+inline T valveExp(T x)
+{
+#if VALVES_FAST_MATH
+	return libs::adsp::fastmath::exp(static_cast<float>(x));
+#else
+	return exp(x);
+#endif
+}
+
+template<typename T>
+inline T valveTanh(T x)
+{
+#if VALVES_FAST_MATH
+	return libs::adsp::fastmath::tanh(static_cast<float>(x));
+#else
+	return tanh(x);
+#endif
+}
+
+template<typename T>
+inline T valveAtan(T x)
+{
+#if VALVES_FAST_MATH
+	return libs::adsp::fastmath::atan(static_cast<float>(x));
+#else
+	return atan(x);
+#endif
+}
+
 // --- helper
 inline float calcMappedVariableOnRange(float inLow, float inHigh,
 										float outLow, float outHigh,
@@ -278,7 +325,7 @@ private:
 			// --- check how far above clip level we are
 			float clipDelta = xn - gridConductionThreshold;
 			clipDelta = fmax(clipDelta, 0.0);
-			float compressionFactor = 0.4473253 + 0.5451584*exp(-0.3241584*clipDelta);
+			float compressionFactor = 0.4473253 + 0.5451584*valveExp(-0.3241584*clipDelta);
 			return compressionFactor*xn;
 		}
 		else
@@ -347,7 +394,7 @@ private:
 					xn /= clipPointNegAbs;
 
 				// --- the waveshaper
-				yn = tanh(k*xn) * tanhk;
+				yn = valveTanh(k*xn) * tanhk;
 
 				// --- undo clip normalize
 				yn *= clipPointNegAbs;
@@ -480,6 +527,11 @@ public:
 		lossyIntegrator[0].reset(_sampleRate);
 		lossyIntegrator[1].reset(_sampleRate);
 
+#if VALVES_ADAA
+		// --- anti-aliased waveshapers
+		pirkleShaperAA[0].reset();
+		pirkleShaperAA[1].reset();
+#endif
 		ZVAFilterParameters params = lossyIntegrator[0].getParameters();
 		params.filterAlgorithm = vaFilterAlgorithm::kLPF1;
 		params.fc = 3.14; // 1 - 10 Hz
@@ -555,8 +607,8 @@ public:
 			dcOffsetNeg = fmin(dcOffsetPos, 0.0);
 
 			// --- (4) do the shaper
-			float yn_Pos = doPirkleWaveShaper(xn_Pos, parameters.waveshaperSaturation, parameters.fixedBiasVoltage, dcOffsetPos*parameters.dcShiftCoefficient);
-			float yn_Neg = doPirkleWaveShaper(xn_Neg, parameters.waveshaperSaturation, parameters.fixedBiasVoltage, dcOffsetNeg*parameters.dcShiftCoefficient);
+			float yn_Pos = doPirkleWaveShaper(xn_Pos, parameters.waveshaperSaturation, parameters.fixedBiasVoltage, dcOffsetPos*parameters.dcShiftCoefficient, 0);
+			float yn_Neg = doPirkleWaveShaper(xn_Neg, parameters.waveshaperSaturation, parameters.fixedBiasVoltage, dcOffsetNeg*parameters.dcShiftCoefficient, 1);
 
 			// --- (5) combine branches, note inversion prior to recombination to re-flip signal
 			yn = yn_Pos - yn_Neg;
@@ -632,7 +684,7 @@ private:
 			// --- check how far above clip level we are
 			float clipDelta = xn - parameters.clipPointPositive;
 			clipDelta = fmax(clipDelta, 0.0);
-			float compressionFactor = 0.4473253 + 0.5451584*exp(-0.3241584*clipDelta);
+			float compressionFactor = 0.4473253 + 0.5451584*valveExp(-0.3241584*clipDelta);
 			return compressionFactor*xn;
 		}
 		else
@@ -651,14 +703,23 @@ private:
 	}
 
 	// --- Pirkle waveshaper (see book addendum)
-	inline float doPirkleWaveShaper(float xn, float g, float fixedDCoffset, float variableDCOffset)
+	inline float doPirkleWaveShaper(float xn, float g, float fixedDCoffset, float variableDCOffset, unsigned int branch)
 	{
 		xn += fixedDCoffset;
 		xn += variableDCOffset;
-		float yn = 1.5*atan(g*xn) * atang;
+#if VALVES_ADAA
+		float yn = 1.5*pirkleShaperAA[branch].process(g*xn) * atang;
+#else
+		float yn = 1.5*valveAtan(g*xn) * atang;
+#endif
 		return yn;
 	}
 
+#if VALVES_ADAA
+	// --- anti-aliased atan waveshapers, one per branch
+	libs::adsp::adaa<libs::adsp::atan_shaper, VALVES_ADAA> pirkleShaperAA[2];
+#endif
+
 	ZVAFilter lossyIntegrator[2];
 	AudioFilter dcBlockingFilter[2];
 	AudioFilter upperBandwidthFilter;
@@ -1457,6 +1518,12 @@ public:
 		// --- do any other per-audio-run inits here
 		sampleRate = _sampleRate;
 
+#if VALVES_ADAA
+		// --- anti-aliased waveshapers
+		turboShaperAA.reset();
+		shaperAA.reset();
+#endif
+
 		// --- BMP Filter
 		toneFilter.reset(_sampleRate);
 		BigMuffToneControlParameters bmParams = toneFilter.getParameters();
@@ -1491,11 +1558,19 @@ public:
 		float yn = inputGain * xn;
 
 		// --- turbo adds pre-distortion
+#if VALVES_ADAA
 		if (parameters.engageTurbo)
-			yn = tanh((saturation / 2.0)*yn) / tanh(saturation / 2.0);
+			yn = turboShaperAA.process((saturation / 2.0)*yn) / valveTanh(saturation / 2.0);
 
 		// --- normal shaper
-		yn = tanh(saturation*yn) / tanh(saturation);
+		yn = shaperAA.process(saturation*yn) / valveTanh(saturation);
+#else
+		if (parameters.engageTurbo)
+			yn = valveTanh((saturation / 2.0)*yn) / valveTanh(saturation / 2.0);
+
+		// --- normal shaper
+		yn = valveTanh(saturation*yn) / valveTanh(saturation);
+#endif
 
 		// --- VariBPF
 		yn = variBPF.processAudioSample(yn);
@@ -1556,6 +1631,12 @@ private:
 
 	VariBPF variBPF;
 	BigMuffToneControl toneFilter;
+
+#if VALVES_ADAA
+	// --- anti-aliased tanh waveshapers
+	libs::adsp::adaa<libs::adsp::tanh_shaper, VALVES_ADAA> turboShaperAA;
+	libs::adsp::adaa<libs::adsp::tanh_shaper, VALVES_ADAA> shaperAA;
+#endif
 };
 
 const unsigned int PREAMP_TRIODES = 4;
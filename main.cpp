@@ -22,6 +22,7 @@
 #ifdef DUAL_CORE_APP
 #ifdef CORE_CM4
 #include "app/ipc/ipc_effect_processor.hpp"
+#include "app/model/dsp_pipeline.hpp"
 
 static void init_thread(void *arg)
 {
@@ -39,6 +40,9 @@ static void init_thread(void *arg)
     auto model = std::make_unique<mfx::ipc_effect_processor>();
     auto ctrl = std::make_unique<mfx::controller>(std::move(model), std::move(view), std::move(settings), std::move(presets));
 
+    /* Processes last effects of chain, when CM7 pipelines them */
+    auto dsp_stage = std::make_unique<mfx::dsp_pipeline_stage>();
+
     vTaskSuspend(xTaskGetCurrentTaskHandle());
 }
 #endif /* CORE_CM4 */
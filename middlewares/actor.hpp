@@ -15,6 +15,9 @@
 
 #include <functional>
 #include <string_view>
+#include <type_traits>
+#include <new>
+#include <array>
 #include <atomic>
 #include <cstdio>
 #include <cassert>
@@ -22,7 +25,11 @@
 namespace middlewares
 {
 
-template<typename I, typename O = void*>
+/*
+ * Actor with event queue & worker thread. Mutable events are allocated on heap (event_pool_size = 0)
+ * or copied into fixed number of slots owned by actor (event_pool_size > 0), immutable events are passed by pointer.
+ */
+template<typename I, typename O = void*, uint32_t event_pool_size = 0>
 class actor
 {
 public:
@@ -32,6 +39,9 @@ public:
         bool immutable {false};
     };
 
+    /* Size of single event (size of one pool slot) */
+    constexpr static size_t event_size = sizeof(event);
+
     struct timed_event
     {
         event evt;
@@ -44,6 +54,19 @@ public:
         this->queue = xQueueCreate(queue_size, sizeof(event*));
         assert(this->queue != nullptr);
 
+        if constexpr (event_pool_size > 0)
+        {
+            /* Create queue of free event slots */
+            this->free_slots = xQueueCreate(event_pool_size, sizeof(event*));
+            assert(this->free_slots != nullptr);
+
+            for (auto &slot : this->event_pool)
+            {
+                event *e = reinterpret_cast<event*>(&slot);
+                xQueueSendToBack(this->free_slots, &e, 0);
+            }
+        }
+
         /* Create worker thread */
         auto result = xTaskCreate(actor::thread_loop, name.data(), stack_size / sizeof(StackType_t), this, priority, &this->task);
         assert(result == pdPASS);
@@ -54,6 +77,12 @@ public:
         vQueueDelete(this->queue);
         this->queue = nullptr;
 
+        if constexpr (event_pool_size > 0)
+        {
+            vQueueDelete(this->free_slots);
+            this->free_slots = nullptr;
+        }
+
         vTaskDelete(this->task);
         this->task = nullptr;
     }
@@ -80,6 +109,11 @@ public:
             assert(!std::is_rvalue_reference<E&&>::value);
             e = &evt;
         }
+        else if constexpr (event_pool_size > 0)
+        {
+            /* Mutable events are copied into free slot */
+            e = new (this->take_slot(timeout)) event(std::forward<E>(evt));
+        }
         else
         {
             /* Mutable (dynamic) events must not be used from interrupt */
@@ -144,6 +178,12 @@ public:
         ctx->target = nullptr;
     }
 
+    /* Maximum number of event slots used at once since start (always 0 if pool is not used) */
+    uint32_t get_event_pool_high_watermark(void) const
+    {
+        return this->slots_high_watermark;
+    }
+
 protected:
     bool wait(uint32_t timeout = portMAX_DELAY)
     {
@@ -169,6 +209,26 @@ protected:
         }
     }
 
+    /* Keep currently dispatched event (and its slot) after dispatch returns, it's freed later with release() */
+    void hold(const event &evt)
+    {
+        assert(&evt == this->dispatched);
+        this->held = true;
+    }
+
+    void release(const event *evt)
+    {
+        if (evt->immutable)
+            return;
+
+        event *e = const_cast<event*>(evt);
+
+        if constexpr (event_pool_size > 0)
+            this->give_slot(e);
+        else
+            delete e;
+    }
+
 private:
     virtual void dispatch(const event &evt) = 0;
 
@@ -176,7 +236,10 @@ private:
     {
         actor *this_ = static_cast<actor*>(arg);
 
-        printf("Actor '%s' started, event size: %u bytes\r\n", pcTaskGetName(this_->task), sizeof(event));
+        if constexpr (event_pool_size > 0)
+            printf("Actor '%s' started, event size: %u bytes, pool: %lu slots\r\n", pcTaskGetName(this_->task), sizeof(event), event_pool_size);
+        else
+            printf("Actor '%s' started, event size: %u bytes\r\n", pcTaskGetName(this_->task), sizeof(event));
 
         while (true)
         {
@@ -184,17 +247,63 @@ private:
 
             if (xQueueReceive(this_->queue, &evt, portMAX_DELAY) == pdTRUE)
             {
+                this_->dispatched = evt;
+                this_->held = false;
                 this_->dispatch(*evt);
 
-                if (!evt->immutable)
-                    delete evt;
+                if (!this_->held)
+                    this_->release(evt);
             }
         }
     }
 
+    void *take_slot(uint32_t timeout)
+    {
+        event *e = nullptr;
+        auto status = pdFALSE;
+
+        if (xPortIsInsideInterrupt())
+        {
+            BaseType_t yield = pdFALSE;
+            status = xQueueReceiveFromISR(this->free_slots, &e, &yield);
+            portYIELD_FROM_ISR(yield);
+        }
+        else
+        {
+            status = xQueueReceive(this->free_slots, &e, pdMS_TO_TICKS(timeout));
+        }
+
+        /* Pool exhausted */
+        assert(status == pdTRUE);
+
+        const uint32_t used = ++this->slots_used;
+        uint32_t watermark = this->slots_high_watermark;
+        while (used > watermark && !this->slots_high_watermark.compare_exchange_weak(watermark, used));
+
+        return e;
+    }
+
+    void give_slot(event *e)
+    {
+        e->~event();
+        this->slots_used--;
+
+        auto status = xQueueSendToBack(this->free_slots, &e, 0);
+        assert(status == pdTRUE);
+    }
+
     std::function<void(O)> callback {};
     QueueHandle_t queue {};
     TaskHandle_t task {};
+    const event *dispatched {nullptr};
+    bool held {false};
+
+    /* Storage for mutable events (used if event_pool_size > 0) */
+    using event_slot = std::aligned_storage_t<sizeof(event), alignof(event)>;
+    std::array<event_slot, event_pool_size> event_pool;
+    QueueHandle_t free_slots {};
+    std::atomic<uint32_t> slots_used {0};
+    std::atomic<uint32_t> slots_high_watermark {0};
 };
 
 }
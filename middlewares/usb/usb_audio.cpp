@@ -8,6 +8,7 @@
 #include "usb_audio.hpp"
 
 #include <cmath>
+#include <cassert>
 #include <array>
 #include <cstring>
 #include <algorithm>
@@ -402,6 +403,7 @@ namespace middlewares
 usb_audio::usb_audio(const hal::interface::audio_volume_range &in_volume_range, const hal::interface::audio_volume_range &out_volume_range)
 {
     this->usb_task = nullptr;
+    this->block_size = mfx::config::dsp_buffer_size;
 
     tusb.itf_count = 0;
     tusb.usb_status = USB_NOT_MOUNTED;
@@ -546,6 +548,12 @@ void usb_audio::notify_mute_changed(bool muted)
     }
 }
 
+void usb_audio::set_block_size(uint16_t samples)
+{
+    assert(samples <= mfx::config::dsp_max_buffer_size);
+    this->block_size = samples;
+}
+
 bool usb_audio::is_enabled(void) const
 {
     return tusb_inited();
@@ -560,13 +568,13 @@ void usb_audio::process()
         return;
     }
 
-    const uint16_t bytes_to_read = audio_from_host.buffer.size() * sizeof(int32_t);
+    const uint16_t bytes_to_read = this->block_size * audio_from_host.channels * sizeof(int32_t);
     const uint16_t bytes_read = tud_audio_read(audio_from_host.buffer.data(), bytes_to_read);
     /* If not enough data, fill remaining buffer with zeroes */
     if (bytes_read < bytes_to_read)
         std::memset(reinterpret_cast<uint8_t*>(audio_from_host.buffer.data()) + bytes_read, 0, bytes_to_read - bytes_read);
 
-    const uint16_t bytes_to_write = audio_to_host.buffer.size() * sizeof(int32_t);
+    const uint16_t bytes_to_write = this->block_size * audio_to_host.channels * sizeof(int32_t);
     const uint16_t bytes_written = tud_audio_write(audio_to_host.buffer.data(), bytes_to_write);
     (void) bytes_written;
 }
@@ -22,8 +22,8 @@ namespace middlewares
 class usb_audio
 {
 public:
-    using input_buffer_t = hal::interface::audio_buffer<int32_t, mfx::config::dsp_buffer_size, 1, 24>;
-    using output_buffer_t = hal::interface::audio_buffer<int32_t, mfx::config::dsp_buffer_size, 2, 24>;
+    using input_buffer_t = hal::interface::audio_buffer<int32_t, mfx::config::dsp_max_buffer_size, 1, 24>;
+    using output_buffer_t = hal::interface::audio_buffer<int32_t, mfx::config::dsp_max_buffer_size, 2, 24>;
 
     usb_audio(const hal::interface::audio_volume_range &in_volume_range, const hal::interface::audio_volume_range &out_volume_range);
     ~usb_audio();
@@ -32,6 +32,7 @@ public:
     void disable(void);
     bool is_enabled(void) const;
     void process();
+    void set_block_size(uint16_t samples);
 
     void set_input_volume_changed_callback(std::function<void(float volume_db)> callback);
     void set_output_volume_changed_callback(std::function<void(float volume_db)> callback);
@@ -46,6 +47,7 @@ public:
 
 private:
     TaskHandle_t usb_task;
+    uint16_t block_size;
 };
 
 } // namespace middlewares
@@ -0,0 +1,62 @@
+% Performs uniformly-partitioned 'overlap-save' fast convolution of signal x with impulse response h
+% Parameters:
+% x - input signal
+% h - impulse response
+% B - block size of input signal (also size of each IR partition)
+% Return:
+% ret - result of convolution
+function [ret] = partitioned_conv (x, h, B)
+
+M = length(x);
+N = length(h);
+
+% FFT size is always two blocks
+K = 2 * B;
+
+% Number of IR partitions
+P = ceil(N / B);
+
+% Calculate the number of input blocks
+num_input_blocks = ceil((M + N - 1) / B);
+
+% Pad x & h to an integer multiple of B
+xp = [x; zeros(num_input_blocks * B - M, 1)];
+hp = [h; zeros(P * B - N, 1)];
+
+ret = zeros(num_input_blocks * B, 1);
+
+% Input buffer
+xw = zeros(K, 1);
+
+% Pre compute FFT of each IR partition
+H = zeros(K, P);
+for p = 0:P-1
+    H(:, p + 1) = fft([hp(p * B + 1:p * B + B); zeros(B, 1)]);
+end
+
+% Frequency-domain delay line of input spectra (newest in the first column)
+FDL = zeros(K, P);
+
+% Convolve all blocks
+for n = 0:num_input_blocks-1
+    % Extract the n-th input block
+    xb = xp(n * B + 1:n * B + B);
+
+    % Sliding window of the input
+    xw = [xw(B + 1:end); xb];
+
+    % Shift delay line & put FFT of current window at its head
+    FDL = circshift(FDL, 1, 2);
+    FDL(:, 1) = fft(xw);
+
+    % Multiply-accumulate over all partitions
+    Y = sum(FDL .* H, 2);
+
+    % Go back to time domain
+    u = real(ifft(Y));
+
+    % Save the valid output samples
+    ret(n * B + 1:n * B + B) = u(end - B + 1:end);
+end
+ret = ret(1:M + N - 1);
+endfunction